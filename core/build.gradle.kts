@@ -33,7 +33,9 @@ android {
                     "-DLIBWEBRTC_INCLUDE_PATH=${projectDir.resolve("deps/webrtc/include")}",
                     "-DLIBWEBRTC_BINARY_ANDROID_PATH=${projectDir.resolve("deps/webrtc/lib")}",
                     "-DLIBMEDIASOUPCLIENT_ROOT_PATH=${projectDir.resolve("deps/libmediasoupclient")}",
-                    "-DMEDIASOUPCLIENT_BUILD_TESTS=OFF"
+                    "-DSIMDJSON_ROOT_PATH=${projectDir.resolve("deps/simdjson")}",
+                    "-DMEDIASOUPCLIENT_BUILD_TESTS=OFF",
+                    "-DMEDIASOUPCLIENT_USE_SIMDJSON=ON"
                 )
             }
         }
@@ -43,6 +45,35 @@ android {
         }
     }
 
+    // "full" bridges the whole mediasoup API. "data" builds libmediasoupclient_data_so.so with only
+    // the Device, transports, DataProducer and DataConsumer, for apps that never send or receive media.
+    flavorDimensions += "bridge"
+    productFlavors {
+        create("full") {
+            dimension = "bridge"
+            isDefault = true
+            buildConfigField("String", "NATIVE_LIBRARY_NAME", "\"mediasoupclient_so\"")
+            externalNativeBuild {
+                cmake {
+                    arguments += "-DMEDIASOUPCLIENT_DATA_ONLY=OFF"
+                }
+            }
+        }
+        create("data") {
+            dimension = "bridge"
+            buildConfigField("String", "NATIVE_LIBRARY_NAME", "\"mediasoupclient_data_so\"")
+            externalNativeBuild {
+                cmake {
+                    arguments += "-DMEDIASOUPCLIENT_DATA_ONLY=ON"
+                }
+            }
+        }
+    }
+
+    buildFeatures {
+        buildConfig = true
+    }
+
     buildTypes {
         debug {
             isJniDebuggable = true
@@ -50,7 +81,9 @@ android {
                 cmake {
                     arguments += listOf(
                         "-DMEDIASOUPCLIENT_LOG_TRACE=ON",
-                        "-DMEDIASOUPCLIENT_LOG_DEV=ON"
+                        "-DMEDIASOUPCLIENT_LOG_DEV=ON",
+                        "-DMEDIASOUPCLIENT_VERIFY_JSON_PARSER=ON",
+                        "-DMEDIASOUPCLIENT_NATIVE_API_TEST=ON"
                     )
                 }
             }
@@ -61,7 +94,9 @@ android {
                 cmake {
                     arguments += listOf(
                         "-DMEDIASOUPCLIENT_LOG_TRACE=OFF",
-                        "-DMEDIASOUPCLIENT_LOG_DEV=OFF"
+                        "-DMEDIASOUPCLIENT_LOG_DEV=OFF",
+                        "-DMEDIASOUPCLIENT_VERIFY_JSON_PARSER=OFF",
+                        "-DMEDIASOUPCLIENT_NATIVE_API_TEST=OFF"
                     )
                 }
             }
@@ -150,7 +185,7 @@ signing {
 
 mavenPublishing {
     configure(AndroidSingleVariantLibrary(
-        variant = "release",
+        variant = "fullRelease",
         javadocJar = JavadocJar.Dokka("dokkaGeneratePublicationJavadoc"),
         sourcesJar = SourcesJar.Sources(),
     ))
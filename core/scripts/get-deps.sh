@@ -32,3 +32,13 @@ pushd $CURDIR/deps/libmediasoupclient
   patch -u -p1 < $CURDIR/scripts/libmediasoupclient_whole_archive.patch
   patch -u -p1 < $CURDIR/scripts/libmediasoupclient_m130.patch
 popd
+
+# simdjson
+rm -rf $CURDIR/deps/simdjson
+if [ ! -e $CURDIR/deps/simdjson.${SIMDJSON_VERSION}.tar.gz ]; then
+  curl -Lo $CURDIR/deps/simdjson.${SIMDJSON_VERSION}.tar.gz https://github.com/simdjson/simdjson/archive/v${SIMDJSON_VERSION}.tar.gz
+fi
+pushd $CURDIR/deps
+  tar xf $CURDIR/deps/simdjson.${SIMDJSON_VERSION}.tar.gz
+  mv simdjson-${SIMDJSON_VERSION} simdjson
+popd
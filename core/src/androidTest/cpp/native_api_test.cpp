@@ -0,0 +1,80 @@
+// JNI bindings of NativeApiTest, which calls mediasoup_native.h the way an app's native code would.
+
+#include <jni.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "mediasoup_native.h"
+
+namespace
+{
+
+struct Counter
+{
+  std::atomic<int64_t> messages{ 0 };
+  std::atomic<int64_t> bytes{ 0 };
+  std::atomic<int64_t> closes{ 0 };
+};
+
+void onMessage(void* userData, const uint8_t*, size_t size, int)
+{
+  auto* counter = static_cast<Counter*>(userData);
+  counter->messages.fetch_add(1);
+  counter->bytes.fetch_add(static_cast<int64_t>(size));
+}
+
+void onClose(void* userData)
+{
+  static_cast<Counter*>(userData)->closes.fetch_add(1);
+}
+
+} // namespace
+
+extern "C"
+{
+
+  JNIEXPORT jlong JNICALL Java_io_github_crow_1misia_mediasoup_NativeApiTest_nativeCreateCounter(JNIEnv*, jclass)
+  {
+    return reinterpret_cast<jlong>(new Counter());
+  }
+
+  JNIEXPORT void JNICALL Java_io_github_crow_1misia_mediasoup_NativeApiTest_nativeDisposeCounter(JNIEnv*, jclass, jlong j_counter)
+  {
+    delete reinterpret_cast<Counter*>(j_counter);
+  }
+
+  JNIEXPORT jlong JNICALL Java_io_github_crow_1misia_mediasoup_NativeApiTest_nativeGetCloses(JNIEnv*, jclass, jlong j_counter)
+  {
+    return reinterpret_cast<Counter*>(j_counter)->closes.load();
+  }
+
+  JNIEXPORT jint JNICALL Java_io_github_crow_1misia_mediasoup_NativeApiTest_nativeSetListener(JNIEnv*, jclass, jlong j_dataConsumer, jlong j_counter)
+  {
+    if (j_counter == 0)
+    {
+      return mediasoup_data_consumer_set_listener(j_dataConsumer, nullptr);
+    }
+    mediasoup_data_consumer_listener listener{ onMessage, onClose, reinterpret_cast<Counter*>(j_counter) };
+    return mediasoup_data_consumer_set_listener(j_dataConsumer, &listener);
+  }
+
+  JNIEXPORT jint JNICALL Java_io_github_crow_1misia_mediasoup_NativeApiTest_nativeSetListenerWithoutOnMessage(JNIEnv*, jclass, jlong j_dataConsumer)
+  {
+    mediasoup_data_consumer_listener listener{ nullptr, onClose, nullptr };
+    return mediasoup_data_consumer_set_listener(j_dataConsumer, &listener);
+  }
+
+  JNIEXPORT jint JNICALL Java_io_github_crow_1misia_mediasoup_NativeApiTest_nativeSend(JNIEnv* env, jclass, jlong j_dataProducer, jbyteArray j_data)
+  {
+    std::vector<uint8_t> data(env->GetArrayLength(j_data));
+    env->GetByteArrayRegion(j_data, 0, static_cast<jsize>(data.size()), reinterpret_cast<jbyte*>(data.data()));
+    return mediasoup_data_producer_send(j_dataProducer, data.data(), data.size(), 1);
+  }
+
+  JNIEXPORT jlong JNICALL Java_io_github_crow_1misia_mediasoup_NativeApiTest_nativeBufferedAmount(JNIEnv*, jclass, jlong j_dataProducer)
+  {
+    return mediasoup_data_producer_buffered_amount(j_dataProducer);
+  }
+}
@@ -0,0 +1,143 @@
+package io.github.crow_misia.mediasoup
+
+import android.os.Bundle
+import android.os.SystemClock
+import android.util.Log
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import androidx.test.platform.app.InstrumentationRegistry
+import com.google.common.truth.Truth.assertThat
+import org.junit.After
+import org.junit.Assert.assertThrows
+import org.junit.Before
+import org.junit.Test
+import org.junit.runner.RunWith
+import org.webrtc.AudioSource
+import org.webrtc.AudioTrack
+import org.webrtc.MediaConstraints
+import org.webrtc.PeerConnectionFactory
+import java.io.File
+
+/**
+ * Device.loadDataOnly(), in both flavors.
+ */
+@RunWith(AndroidJUnit4::class)
+class DataOnlyDeviceTest {
+    private lateinit var factory: PeerConnectionFactory
+    private lateinit var device: Device
+
+    @Before
+    fun setUp() {
+        factory = TestEnvironment.createPeerConnectionFactory()
+        device = factory.createDevice()
+    }
+
+    @After
+    fun tearDown() {
+        device.dispose()
+        factory.dispose()
+    }
+
+    @Test
+    fun cannotProduceOrConsume() {
+        device.loadDataOnly()
+
+        assertThat(device.loaded).isTrue()
+        assertThat(device.canProduce("audio")).isFalse()
+        assertThat(device.canProduce("video")).isFalse()
+
+        val recvTransport = TestEnvironment.createRecvTransport(device)
+        val sendTransport = TestEnvironment.createSendTransport(device)
+        val audioSource: AudioSource = factory.createAudioSource(MediaConstraints())
+        val audioTrack: AudioTrack = factory.createAudioTrack("audio", audioSource)
+        try {
+            assertThrows(MediasoupException::class.java) {
+                recvTransport.consume(
+                    listener = TestEnvironment.ConsumerListener,
+                    id = "consumer",
+                    producerId = "producer",
+                    kind = "audio",
+                    rtpParameters = FakeParameters.audioConsumerRtpParameters(0),
+                )
+            }
+            assertThrows(MediasoupException::class.java) {
+                sendTransport.produce(TestEnvironment.ProducerListener, audioTrack)
+            }
+        } finally {
+            audioTrack.dispose()
+            audioSource.dispose()
+            sendTransport.dispose()
+            recvTransport.dispose()
+        }
+    }
+
+    @Test
+    fun exchangesDataChannels() {
+        device.loadDataOnly()
+        val recvTransport = TestEnvironment.createRecvTransport(device)
+        val sendTransport = TestEnvironment.createSendTransport(device)
+        try {
+            val dataConsumer = recvTransport.consumeData(
+                listener = TestEnvironment.DataConsumerListener,
+                id = "dataConsumer",
+                producerId = "dataProducer",
+                streamId = 1,
+                label = "chat",
+            )
+            val dataProducer = sendTransport.produceData(listener = TestEnvironment.DataProducerListener, label = "chat")
+
+            assertThat(dataConsumer.label).isEqualTo("chat")
+            assertThat(dataProducer.label).isEqualTo("chat")
+            dataProducer.dispose()
+            dataConsumer.dispose()
+        } finally {
+            sendTransport.dispose()
+            recvTransport.dispose()
+        }
+    }
+
+    /**
+     * Time and resident memory of a load and [TRANSPORTS] receive transports, in each mode.
+     * Logged under the DataOnlyDevice tag and reported as instrumentation status, nothing is asserted.
+     */
+    @Test
+    fun reportsLoadCosts() {
+        val results = Bundle()
+        measureLoad(results, "full") { it.load(FakeParameters.ROUTER_RTP_CAPABILITIES) }
+        measureLoad(results, "dataOnly") { it.loadDataOnly() }
+
+        Log.i(TAG, results.keySet().sorted().joinToString { "$it=${results.getLong(it)}" })
+        InstrumentationRegistry.getInstrumentation().sendStatus(0, results)
+    }
+
+    private fun measureLoad(results: Bundle, mode: String, load: (Device) -> Unit) {
+        val measured = factory.createDevice()
+        try {
+            val rssBefore = residentKilobytes()
+            val start = SystemClock.elapsedRealtimeNanos()
+            load(measured)
+            val loaded = SystemClock.elapsedRealtimeNanos()
+            val transports = List(TRANSPORTS) { TestEnvironment.createRecvTransport(measured, "recv$it") }
+            val created = SystemClock.elapsedRealtimeNanos()
+            val rssAfter = residentKilobytes()
+            transports.forEach { it.dispose() }
+
+            results.putLong("${mode}LoadMicros", (loaded - start) / 1000)
+            results.putLong("${mode}TransportsMicros", (created - loaded) / 1000)
+            results.putLong("${mode}RssDeltaKb", rssAfter - rssBefore)
+        } finally {
+            measured.dispose()
+        }
+    }
+
+    private fun residentKilobytes(): Long {
+        return File("/proc/self/status").readLines()
+            .first { it.startsWith("VmRSS:") }
+            .filter { it.isDigit() }
+            .toLong()
+    }
+
+    private companion object {
+        const val TAG = "DataOnlyDevice"
+        const val TRANSPORTS = 10
+    }
+}
@@ -0,0 +1,74 @@
+package io.github.crow_misia.mediasoup
+
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import com.google.common.truth.Truth.assertThat
+import org.junit.After
+import org.junit.Before
+import org.junit.Test
+import org.junit.runner.RunWith
+import org.webrtc.PeerConnectionFactory
+
+@RunWith(AndroidJUnit4::class)
+class DeviceTest {
+    private lateinit var factory: PeerConnectionFactory
+    private lateinit var device: Device
+
+    @Before
+    fun setUp() {
+        factory = TestEnvironment.createPeerConnectionFactory()
+        device = factory.createDevice()
+    }
+
+    @After
+    fun tearDown() {
+        device.dispose()
+        factory.dispose()
+    }
+
+    @Test
+    fun loadWithoutFilterKeepsEveryCodec() {
+        device.load(FakeParameters.ROUTER_RTP_CAPABILITIES)
+
+        assertThat(device.canProduce("audio")).isTrue()
+        assertThat(device.canProduce("video")).isTrue()
+        assertThat(device.findCodec("video/VP8")).isNotNull()
+        assertThat(device.rtpCapabilities).contains("video/rtx")
+    }
+
+    @Test
+    fun capabilityFilterRemovesOtherCodecs() {
+        device.load(FakeParameters.ROUTER_RTP_CAPABILITIES, capabilityFilter = RtpCapabilityFilter(mimeTypes = listOf("AUDIO/OPUS")))
+
+        assertThat(device.canProduce("audio")).isTrue()
+        assertThat(device.canProduce("video")).isFalse()
+        assertThat(device.findCodec("audio/opus")).isNotNull()
+        assertThat(device.findCodec("video/VP8")).isNull()
+        assertThat(device.rtpCapabilities).doesNotContain("video/rtx")
+    }
+
+    @Test
+    fun capabilityFilterKeepsRtxOfKeptCodecs() {
+        device.load(FakeParameters.ROUTER_RTP_CAPABILITIES, capabilityFilter = RtpCapabilityFilter(mimeTypes = listOf("video/VP8")))
+
+        assertThat(device.canProduce("audio")).isFalse()
+        assertThat(device.canProduce("video")).isTrue()
+        assertThat(device.rtpCapabilities).contains("video/rtx")
+    }
+
+    @Test
+    fun capabilityFilterRemovesHeaderExtensionsAndFeedback() {
+        device.load(
+            FakeParameters.ROUTER_RTP_CAPABILITIES,
+            capabilityFilter = RtpCapabilityFilter(
+                headerExtensions = listOf("urn:ietf:params:rtp-hdrext:sdes:mid"),
+                rtcpFeedback = listOf("nack"),
+            ),
+        )
+
+        val capabilities = device.rtpCapabilities
+        assertThat(capabilities).contains("urn:ietf:params:rtp-hdrext:sdes:mid")
+        assertThat(capabilities).doesNotContain("transport-wide-cc-extensions")
+        assertThat(capabilities).doesNotContain("goog-remb")
+        assertThat(capabilities).contains("nack")
+    }
+}
@@ -0,0 +1,83 @@
+package io.github.crow_misia.mediasoup
+
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import com.google.common.truth.Truth.assertThat
+import org.json.JSONObject
+import org.junit.After
+import org.junit.Assert.assertThrows
+import org.junit.Before
+import org.junit.Test
+import org.junit.runner.RunWith
+import org.webrtc.PeerConnectionFactory
+import java.util.concurrent.TimeUnit
+
+@RunWith(AndroidJUnit4::class)
+class DtlsCertificateProviderTest {
+    private lateinit var factory: PeerConnectionFactory
+
+    @Before
+    fun setUp() {
+        factory = TestEnvironment.createPeerConnectionFactory()
+    }
+
+    @After
+    fun tearDown() {
+        factory.dispose()
+    }
+
+    @Test
+    fun transportsReuseTheGeneratedCertificate() {
+        val provider = DtlsCertificateProvider()
+        val device = factory.createDevice()
+        try {
+            assertThat(provider.exportPem()).isNotNull()
+            device.setCertificateProvider(provider)
+            device.load(FakeParameters.ROUTER_RTP_CAPABILITIES)
+            val transports = List(3) { TestEnvironment.createRecvTransport(device, "recv$it") }
+            transports.forEach { it.dispose() }
+
+            val metrics = JSONObject(provider.metrics)
+            assertThat(metrics.getLong("generated")).isEqualTo(1L)
+            assertThat(metrics.getLong("reused")).isAtLeast(3L)
+            assertThat(metrics.getLong("waits")).isEqualTo(0L)
+        } finally {
+            device.dispose()
+            provider.dispose()
+        }
+    }
+
+    @Test
+    fun importTakesALongerLivedCertificateOnly() {
+        val longLived = DtlsCertificateProvider(TimeUnit.DAYS.toMillis(7))
+        val shortLived = DtlsCertificateProvider(TimeUnit.DAYS.toMillis(1))
+        try {
+            val longPem = checkNotNull(longLived.exportPem())
+            val shortPem = checkNotNull(shortLived.exportPem())
+
+            longLived.importPem(shortPem)
+            shortLived.importPem(longPem)
+
+            assertThat(longLived.exportPem()?.certificate).isEqualTo(longPem.certificate)
+            assertThat(shortLived.exportPem()?.certificate).isEqualTo(longPem.certificate)
+        } finally {
+            shortLived.dispose()
+            longLived.dispose()
+        }
+    }
+
+    @Test
+    fun rejectsLifetimesUnderOneSecond() {
+        TestEnvironment.initialize()
+
+        assertThrows(IllegalArgumentException::class.java) { DtlsCertificateProvider(999L) }
+    }
+
+    @Test
+    fun disposedProviderCannotBeUsed() {
+        TestEnvironment.initialize()
+        val provider = DtlsCertificateProvider()
+        provider.dispose()
+
+        assertThrows(IllegalStateException::class.java) { provider.metrics }
+    }
+}
@@ -0,0 +1,79 @@
+package io.github.crow_misia.mediasoup
+
+/**
+ * Server side parameters of a mediasoup router, enough to negotiate transports locally.
+ * No packet ever flows, as the candidates point nowhere.
+ */
+object FakeParameters {
+    const val ROUTER_RTP_CAPABILITIES = """
+{
+  "codecs": [
+    {
+      "mimeType": "audio/opus", "kind": "audio", "preferredPayloadType": 100, "clockRate": 48000, "channels": 2,
+      "parameters": { "useinbandfec": 1 }, "rtcpFeedback": [{ "type": "transport-cc" }]
+    },
+    {
+      "mimeType": "video/VP8", "kind": "video", "preferredPayloadType": 101, "clockRate": 90000,
+      "parameters": {},
+      "rtcpFeedback": [
+        { "type": "nack" }, { "type": "nack", "parameter": "pli" }, { "type": "ccm", "parameter": "fir" },
+        { "type": "goog-remb" }, { "type": "transport-cc" }
+      ]
+    },
+    {
+      "mimeType": "video/rtx", "kind": "video", "preferredPayloadType": 102, "clockRate": 90000,
+      "parameters": { "apt": 101 }, "rtcpFeedback": []
+    }
+  ],
+  "headerExtensions": [
+    { "kind": "audio", "uri": "urn:ietf:params:rtp-hdrext:sdes:mid", "preferredId": 1, "preferredEncrypt": false, "direction": "sendrecv" },
+    { "kind": "video", "uri": "urn:ietf:params:rtp-hdrext:sdes:mid", "preferredId": 1, "preferredEncrypt": false, "direction": "sendrecv" },
+    { "kind": "audio", "uri": "urn:ietf:params:rtp-hdrext:ssrc-audio-level", "preferredId": 10, "preferredEncrypt": false, "direction": "sendrecv" },
+    { "kind": "video", "uri": "http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01", "preferredId": 5, "preferredEncrypt": false, "direction": "sendrecv" }
+  ]
+}
+"""
+
+    const val ICE_PARAMETERS = """
+{ "iceLite": true, "password": "yku5ej8nvfaor28lvtrabcx0wkrpkztz", "usernameFragment": "h3hk1iz6qqlnqlne" }
+"""
+
+    const val ICE_CANDIDATES = """
+[
+  { "foundation": "udpcandidate", "ip": "192.0.2.1", "port": 40533, "priority": 1078862079, "protocol": "udp", "type": "host" }
+]
+"""
+
+    const val DTLS_PARAMETERS = """
+{
+  "fingerprints": [
+    { "algorithm": "sha-256", "value": "A9:F4:E0:D2:74:D3:0F:D9:2E:69:5E:E7:EA:F1:48:5E:B2:E7:08:24:0D:B3:19:30:4D:F8:2A:0A:83:F2:E2:1B" }
+  ],
+  "role": "auto"
+}
+"""
+
+    const val SCTP_PARAMETERS = """
+{ "port": 5000, "OS": 1024, "MIS": 1024, "maxMessageSize": 262144 }
+"""
+
+    /**
+     * RTP parameters of an opus Consumer, each [index] with its own SSRC and CNAME.
+     */
+    fun audioConsumerRtpParameters(index: Int): String = """
+{
+  "codecs": [
+    {
+      "mimeType": "audio/opus", "payloadType": 100, "clockRate": 48000, "channels": 2,
+      "parameters": { "useinbandfec": 1 }, "rtcpFeedback": [{ "type": "transport-cc" }]
+    }
+  ],
+  "encodings": [{ "ssrc": ${10_000_000 + index} }],
+  "headerExtensions": [
+    { "uri": "urn:ietf:params:rtp-hdrext:sdes:mid", "id": 1 },
+    { "uri": "urn:ietf:params:rtp-hdrext:ssrc-audio-level", "id": 10 }
+  ],
+  "rtcp": { "cname": "consumer$index", "reducedSize": true, "mux": true }
+}
+"""
+}
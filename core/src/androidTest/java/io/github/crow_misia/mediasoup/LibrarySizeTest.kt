@@ -0,0 +1,38 @@
+package io.github.crow_misia.mediasoup
+
+import android.os.Build
+import android.os.Bundle
+import android.util.Log
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import androidx.test.platform.app.InstrumentationRegistry
+import com.google.common.truth.Truth.assertThat
+import org.junit.Test
+import org.junit.runner.RunWith
+import java.util.zip.ZipFile
+
+/**
+ * Size of the bridge of the flavor under test, for the ABI of the device.
+ * Logged under the LibrarySize tag and reported as instrumentation status. Compare the runs of
+ * connectedFullDebugAndroidTest and connectedDataDebugAndroidTest; StartupTimingTest gives the load time.
+ */
+@RunWith(AndroidJUnit4::class)
+class LibrarySizeTest {
+    @Test
+    fun reportsLibrarySize() {
+        val name = "lib/${Build.SUPPORTED_ABIS[0]}/lib${BuildConfig.NATIVE_LIBRARY_NAME}.so"
+        val results = Bundle()
+        ZipFile(InstrumentationRegistry.getInstrumentation().targetContext.applicationInfo.sourceDir).use { apk ->
+            val entry = apk.getEntry(name)
+            assertThat(entry).isNotNull()
+            results.putLong("libraryBytes", entry.size)
+            results.putLong("compressedLibraryBytes", entry.compressedSize)
+        }
+
+        Log.i(TAG, "$name: " + results.keySet().joinToString { "$it=${results.getLong(it)}" })
+        InstrumentationRegistry.getInstrumentation().sendStatus(0, results)
+    }
+
+    private companion object {
+        const val TAG = "LibrarySize"
+    }
+}
@@ -0,0 +1,133 @@
+package io.github.crow_misia.mediasoup
+
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import com.google.common.truth.Truth.assertThat
+import org.junit.After
+import org.junit.Before
+import org.junit.Test
+import org.junit.runner.RunWith
+import org.webrtc.PeerConnectionFactory
+
+/**
+ * The C API of mediasoup_native.h, called through libmediasoupclient_native_test.so of debug builds.
+ * Without a server no message gets through, so only the handles, the listener and the close are checked.
+ */
+@RunWith(AndroidJUnit4::class)
+class NativeApiTest {
+    private lateinit var factory: PeerConnectionFactory
+    private lateinit var device: Device
+
+    @Before
+    fun setUp() {
+        factory = TestEnvironment.createPeerConnectionFactory()
+        System.loadLibrary("mediasoupclient_native_test")
+        device = TestEnvironment.createLoadedDevice(factory)
+    }
+
+    @After
+    fun tearDown() {
+        device.dispose()
+        factory.dispose()
+    }
+
+    @Test
+    fun rejectsInvalidArguments() {
+        val counter = nativeCreateCounter()
+        try {
+            assertThat(nativeSetListener(0L, counter)).isEqualTo(INVALID_ARGUMENT)
+            assertThat(nativeSend(0L, ByteArray(1))).isEqualTo(INVALID_ARGUMENT)
+            assertThat(nativeBufferedAmount(0L)).isEqualTo(INVALID_ARGUMENT.toLong())
+        } finally {
+            nativeDisposeCounter(counter)
+        }
+    }
+
+    @Test
+    fun nativeListenerIsToldOfTransportClose() {
+        val transport = TestEnvironment.createRecvTransport(device)
+        val dataConsumer = transport.consumeData(
+            listener = TestEnvironment.DataConsumerListener,
+            id = "dataConsumer",
+            producerId = "dataProducer",
+            streamId = 1,
+            label = "native",
+        )
+        val counter = nativeCreateCounter()
+        try {
+            assertThat(nativeSetListenerWithoutOnMessage(dataConsumer.nativeHandle)).isEqualTo(INVALID_ARGUMENT)
+            assertThat(nativeSetListener(dataConsumer.nativeHandle, counter)).isEqualTo(OK)
+
+            transport.close()
+
+            assertThat(nativeGetCloses(counter)).isEqualTo(1L)
+        } finally {
+            dataConsumer.dispose()
+            transport.dispose()
+            nativeDisposeCounter(counter)
+        }
+    }
+
+    @Test
+    fun removedNativeListenerIsNotCalled() {
+        val transport = TestEnvironment.createRecvTransport(device)
+        val dataConsumer = transport.consumeData(
+            listener = TestEnvironment.DataConsumerListener,
+            id = "dataConsumer",
+            producerId = "dataProducer",
+            streamId = 1,
+            label = "native",
+        )
+        val counter = nativeCreateCounter()
+        try {
+            assertThat(nativeSetListener(dataConsumer.nativeHandle, counter)).isEqualTo(OK)
+            assertThat(nativeSetListener(dataConsumer.nativeHandle, 0L)).isEqualTo(OK)
+
+            transport.close()
+
+            assertThat(nativeGetCloses(counter)).isEqualTo(0L)
+        } finally {
+            dataConsumer.dispose()
+            transport.dispose()
+            nativeDisposeCounter(counter)
+        }
+    }
+
+    @Test
+    fun sendsOnDataProducerHandle() {
+        val transport = TestEnvironment.createSendTransport(device)
+        val dataProducer = transport.produceData(listener = TestEnvironment.DataProducerListener, label = "native")
+        try {
+            assertThat(nativeSend(dataProducer.nativeHandle, ByteArray(16))).isNotEqualTo(INVALID_ARGUMENT)
+            assertThat(nativeBufferedAmount(dataProducer.nativeHandle)).isAtLeast(0L)
+        } finally {
+            dataProducer.dispose()
+            transport.dispose()
+        }
+    }
+
+    private companion object {
+        const val OK = 0
+        const val INVALID_ARGUMENT = -1
+
+        @JvmStatic
+        external fun nativeCreateCounter(): Long
+
+        @JvmStatic
+        external fun nativeDisposeCounter(counter: Long)
+
+        @JvmStatic
+        external fun nativeGetCloses(counter: Long): Long
+
+        @JvmStatic
+        external fun nativeSetListener(dataConsumer: Long, counter: Long): Int
+
+        @JvmStatic
+        external fun nativeSetListenerWithoutOnMessage(dataConsumer: Long): Int
+
+        @JvmStatic
+        external fun nativeSend(dataProducer: Long, data: ByteArray): Int
+
+        @JvmStatic
+        external fun nativeBufferedAmount(dataProducer: Long): Long
+    }
+}
@@ -0,0 +1,123 @@
+package io.github.crow_misia.mediasoup
+
+import android.os.Bundle
+import android.os.SystemClock
+import android.util.Log
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import androidx.test.platform.app.InstrumentationRegistry
+import com.google.common.truth.Truth.assertThat
+import org.junit.After
+import org.junit.Assert.assertThrows
+import org.junit.Before
+import org.junit.Test
+import org.junit.runner.RunWith
+import org.webrtc.PeerConnectionFactory
+import java.util.concurrent.Executors
+import java.util.concurrent.TimeUnit
+
+@RunWith(AndroidJUnit4::class)
+class PeerConnectionFactoryPoolTest {
+    private lateinit var pool: PeerConnectionFactoryPool
+
+    @Before
+    fun setUp() {
+        pool = PeerConnectionFactoryPool.create(SIZE) { TestEnvironment.createPeerConnectionFactory() }
+    }
+
+    @After
+    fun tearDown() {
+        pool.dispose()
+    }
+
+    @Test
+    fun nextIsRoundRobin() {
+        val handedOut = List(SIZE * 2) { pool.next() }
+
+        assertThat(handedOut).containsExactlyElementsIn(pool.factories + pool.factories).inOrder()
+    }
+
+    @Test
+    fun forAffinityIsStable() {
+        val first = List(10) { pool.forAffinity("room$it") }
+        val second = List(10) { pool.forAffinity("room$it") }
+
+        assertThat(second).isEqualTo(first)
+        assertThat(pool.factories).containsAtLeastElementsIn(first)
+    }
+
+    @Test
+    fun measuresEveryFactory() {
+        ThreadPolicy.Target.values().forEach { target ->
+            val delays = pool.measureQueueDelays(target)
+            assertThat(delays.size).isEqualTo(SIZE)
+            delays.forEach { assertThat(it).isAtLeast(0L) }
+        }
+    }
+
+    @Test
+    fun rejectsEmptyPools() {
+        assertThrows(IllegalArgumentException::class.java) { PeerConnectionFactoryPool(emptyList()) }
+        assertThrows(IllegalArgumentException::class.java) { PeerConnectionFactoryPool.create(0) { pool.next() } }
+    }
+
+    /**
+     * Time to create [TRANSPORTS] transports with a DataConsumer each from as many threads, all on one factory
+     * and spread over the pool. Logged under the FactoryPool tag and reported as instrumentation status.
+     */
+    @Test
+    fun reportsConcurrentNegotiations() {
+        val device = TestEnvironment.createLoadedDevice(pool.factories[0])
+        try {
+            val single = pool.factories[0]
+            val results = Bundle().apply {
+                putLong("singleFactoryMicros", negotiateConcurrently(device) { single })
+                putLong("poolMicros", negotiateConcurrently(device) { pool.next() })
+            }
+
+            Log.i(TAG, results.keySet().joinToString { "$it=${results.getLong(it)}" })
+            InstrumentationRegistry.getInstrumentation().sendStatus(0, results)
+        } finally {
+            device.dispose()
+        }
+    }
+
+    private fun negotiateConcurrently(device: Device, factory: () -> PeerConnectionFactory): Long {
+        val executor = Executors.newFixedThreadPool(TRANSPORTS)
+        try {
+            val start = SystemClock.elapsedRealtimeNanos()
+            val transports = List(TRANSPORTS) { index ->
+                val transportFactory = factory()
+                executor.submit<RecvTransport> {
+                    val transport = device.createRecvTransport(
+                        listener = TestEnvironment.RecvTransportListener,
+                        id = "recv$index",
+                        iceParameters = FakeParameters.ICE_PARAMETERS,
+                        iceCandidates = FakeParameters.ICE_CANDIDATES,
+                        dtlsParameters = FakeParameters.DTLS_PARAMETERS,
+                        sctpParameters = FakeParameters.SCTP_PARAMETERS,
+                        factory = transportFactory,
+                    )
+                    transport.consumeData(
+                        listener = TestEnvironment.DataConsumerListener,
+                        id = "dataConsumer$index",
+                        producerId = "dataProducer$index",
+                        streamId = 1,
+                        label = "data",
+                    ).dispose()
+                    transport
+                }
+            }.map { it.get(60, TimeUnit.SECONDS) }
+            val elapsed = SystemClock.elapsedRealtimeNanos() - start
+            transports.forEach { it.dispose() }
+            return elapsed / 1000
+        } finally {
+            executor.shutdown()
+        }
+    }
+
+    private companion object {
+        const val TAG = "FactoryPool"
+        const val SIZE = 3
+        const val TRANSPORTS = 6
+    }
+}
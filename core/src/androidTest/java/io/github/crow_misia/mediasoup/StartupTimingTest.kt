@@ -0,0 +1,60 @@
+package io.github.crow_misia.mediasoup
+
+import android.os.Bundle
+import android.os.SystemClock
+import android.util.Log
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import androidx.test.platform.app.InstrumentationRegistry
+import com.google.common.truth.Truth.assertThat
+import org.junit.Assume.assumeFalse
+import org.junit.Test
+import org.junit.runner.RunWith
+
+/**
+ * Cold start of the native library: JNI_OnLoad, then the first Device, which resolves the classes and methods
+ * the bridge calls back, then a second one for comparison.
+ * Only meaningful as the first test of the process, run it on its own:
+ *
+ *   ./gradlew :core:connectedFullDebugAndroidTest \
+ *     -Pandroid.testInstrumentationRunnerArguments.class=io.github.crow_misia.mediasoup.StartupTimingTest
+ *
+ * The timings are logged under the StartupTiming tag and reported as instrumentation status.
+ */
+@RunWith(AndroidJUnit4::class)
+class StartupTimingTest {
+    @Test
+    fun coldStart() {
+        assumeFalse("the native library is already loaded in this process", TestEnvironment.initialized)
+
+        val loadNanos = measure { TestEnvironment.initialize() }
+        val factory = TestEnvironment.createPeerConnectionFactory()
+        lateinit var first: Device
+        val firstDeviceNanos = measure { first = factory.createDevice() }
+        lateinit var second: Device
+        val secondDeviceNanos = measure { second = factory.createDevice() }
+
+        assertThat(first.loaded).isFalse()
+        assertThat(second.loaded).isFalse()
+        second.dispose()
+        first.dispose()
+        factory.dispose()
+
+        val results = Bundle().apply {
+            putLong("loadMicros", loadNanos / 1000)
+            putLong("firstDeviceMicros", firstDeviceNanos / 1000)
+            putLong("secondDeviceMicros", secondDeviceNanos / 1000)
+        }
+        Log.i(TAG, results.keySet().joinToString { "$it=${results.getLong(it)}" })
+        InstrumentationRegistry.getInstrumentation().sendStatus(0, results)
+    }
+
+    private inline fun measure(block: () -> Unit): Long {
+        val start = SystemClock.elapsedRealtimeNanos()
+        block()
+        return SystemClock.elapsedRealtimeNanos() - start
+    }
+
+    private companion object {
+        const val TAG = "StartupTiming"
+    }
+}
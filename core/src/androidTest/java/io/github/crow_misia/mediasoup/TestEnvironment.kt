@@ -0,0 +1,111 @@
+package io.github.crow_misia.mediasoup
+
+import androidx.test.platform.app.InstrumentationRegistry
+import org.webrtc.DataChannel
+import org.webrtc.PeerConnectionFactory
+
+/**
+ * Loads the native library once, and builds the objects the tests share.
+ */
+object TestEnvironment {
+    @Volatile
+    var initialized = false
+        private set
+
+    /**
+     * Initializes WebRTC with the library of the flavor under test, which runs its JNI_OnLoad.
+     */
+    @Synchronized
+    fun initialize() {
+        if (initialized) {
+            return
+        }
+        val context = InstrumentationRegistry.getInstrumentation().targetContext.applicationContext
+        PeerConnectionFactory.initialize(
+            PeerConnectionFactory.InitializationOptions.builder(context)
+                .setNativeLibraryName(BuildConfig.NATIVE_LIBRARY_NAME)
+                .createInitializationOptions()
+        )
+        initialized = true
+    }
+
+    fun createPeerConnectionFactory(): PeerConnectionFactory {
+        initialize()
+        return PeerConnectionFactory.builder().createPeerConnectionFactory()
+    }
+
+    fun createLoadedDevice(factory: PeerConnectionFactory): Device {
+        return factory.createDevice().also { it.load(FakeParameters.ROUTER_RTP_CAPABILITIES) }
+    }
+
+    fun createRecvTransport(device: Device, id: String = "recv"): RecvTransport {
+        return device.createRecvTransport(
+            listener = RecvTransportListener,
+            id = id,
+            iceParameters = FakeParameters.ICE_PARAMETERS,
+            iceCandidates = FakeParameters.ICE_CANDIDATES,
+            dtlsParameters = FakeParameters.DTLS_PARAMETERS,
+            sctpParameters = FakeParameters.SCTP_PARAMETERS,
+        )
+    }
+
+    fun createSendTransport(device: Device, id: String = "send"): SendTransport {
+        return device.createSendTransport(
+            listener = SendTransportListener,
+            id = id,
+            iceParameters = FakeParameters.ICE_PARAMETERS,
+            iceCandidates = FakeParameters.ICE_CANDIDATES,
+            dtlsParameters = FakeParameters.DTLS_PARAMETERS,
+            sctpParameters = FakeParameters.SCTP_PARAMETERS,
+        )
+    }
+
+    /**
+     * Accepts the connection without a server, as the tests only negotiate locally.
+     */
+    object RecvTransportListener : RecvTransport.Listener {
+        override fun onConnect(transport: Transport, dtlsParameters: String) = Unit
+        override fun onConnectionStateChange(transport: Transport, newState: String) = Unit
+    }
+
+    object SendTransportListener : SendTransport.Listener {
+        private var nextId = 0
+
+        override fun onConnect(transport: Transport, dtlsParameters: String) = Unit
+        override fun onConnectionStateChange(transport: Transport, newState: String) = Unit
+
+        @Synchronized
+        override fun onProduce(transport: Transport, kind: String, rtpParameters: String, appData: String?): String {
+            return "producer${nextId++}"
+        }
+
+        @Synchronized
+        override fun onProduceData(transport: Transport, sctpStreamParameters: String, label: String, protocol: String, appData: String?): String {
+            return "dataProducer${nextId++}"
+        }
+    }
+
+    object ProducerListener : Producer.Listener {
+        override fun onTransportClose(producer: Producer) = Unit
+    }
+
+    object ConsumerListener : Consumer.Listener {
+        override fun onTransportClose(consumer: Consumer) = Unit
+    }
+
+    object DataProducerListener : DataProducer.Listener {
+        override fun onOpen(dataProducer: DataProducer) = Unit
+        override fun onClose(dataProducer: DataProducer) = Unit
+        override fun onBufferedAmountChange(dataProducer: DataProducer, sentDataSize: Long) = Unit
+        override fun onTransportClose(dataProducer: DataProducer) = Unit
+    }
+
+    object DataConsumerListener : DataConsumer.Listener {
+        override fun onConnecting(dataConsumer: DataConsumer) = Unit
+        override fun onOpen(dataConsumer: DataConsumer) = Unit
+        override fun onClosing(dataConsumer: DataConsumer) = Unit
+        override fun onClose(dataConsumer: DataConsumer) = Unit
+        override fun onMessage(dataConsumer: DataConsumer, buffer: DataChannel.Buffer) = Unit
+        override fun onTransportClose(dataConsumer: DataConsumer) = Unit
+    }
+}
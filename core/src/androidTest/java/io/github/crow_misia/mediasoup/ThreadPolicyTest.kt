@@ -0,0 +1,51 @@
+package io.github.crow_misia.mediasoup
+
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import com.google.common.truth.Truth.assertThat
+import org.junit.After
+import org.junit.Assert.assertThrows
+import org.junit.Before
+import org.junit.Test
+import org.junit.runner.RunWith
+import org.webrtc.PeerConnectionFactory
+
+@RunWith(AndroidJUnit4::class)
+class ThreadPolicyTest {
+    private lateinit var factory: PeerConnectionFactory
+
+    @Before
+    fun setUp() {
+        factory = TestEnvironment.createPeerConnectionFactory()
+    }
+
+    @After
+    fun tearDown() {
+        factory.dispose()
+    }
+
+    @Test
+    fun lowerPriorityAndPinToFirstCpuAreApplied() {
+        // An app may always lower the priority of its threads, and restrict them to a CPU it runs on.
+        val policy = ThreadPolicy(cpuAffinity = 1L, niceValue = 10)
+
+        assertThat(factory.setThreadPolicies(network = policy, worker = policy, signaling = policy)).isTrue()
+    }
+
+    @Test
+    fun emptyPolicyChangesNothing() {
+        assertThat(ThreadPolicy().applyTo(factory, ThreadPolicy.Target.SIGNALING)).isTrue()
+    }
+
+    @Test
+    fun queueDelayIsMeasuredOnEveryThread() {
+        ThreadPolicy.Target.values().forEach {
+            assertThat(factory.measureQueueDelay(it)).isAtLeast(0L)
+        }
+    }
+
+    @Test
+    fun outOfRangeValuesAreRejected() {
+        assertThrows(IllegalArgumentException::class.java) { ThreadPolicy(niceValue = 20) }
+        assertThrows(IllegalArgumentException::class.java) { ThreadPolicy(realtimePriority = 100) }
+    }
+}
@@ -0,0 +1,68 @@
+package io.github.crow_misia.mediasoup
+
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import androidx.test.platform.app.InstrumentationRegistry
+import com.google.common.truth.Truth.assertThat
+import org.junit.After
+import org.junit.Assert.assertThrows
+import org.junit.Before
+import org.junit.Test
+import org.junit.runner.RunWith
+import org.webrtc.PeerConnectionFactory
+import java.util.zip.ZipFile
+
+/**
+ * libmediasoupclient_data_so.so of the data flavor: it is the only bridge packaged, its JNI_OnLoad registers
+ * every native the Kotlin classes declare, and the media entry points fail with MediasoupException.
+ */
+@RunWith(AndroidJUnit4::class)
+class DataLibraryTest {
+    private lateinit var factory: PeerConnectionFactory
+    private lateinit var device: Device
+
+    @Before
+    fun setUp() {
+        factory = TestEnvironment.createPeerConnectionFactory()
+        device = TestEnvironment.createLoadedDevice(factory)
+    }
+
+    @After
+    fun tearDown() {
+        device.dispose()
+        factory.dispose()
+    }
+
+    @Test
+    fun onlyTheDataLibraryIsPackaged() {
+        val libraries = ZipFile(InstrumentationRegistry.getInstrumentation().targetContext.applicationInfo.sourceDir).use { apk ->
+            apk.entries().asSequence().map { it.name.substringAfterLast('/') }.toSet()
+        }
+
+        assertThat(BuildConfig.NATIVE_LIBRARY_NAME).isEqualTo("mediasoupclient_data_so")
+        assertThat(libraries).contains("libmediasoupclient_data_so.so")
+        assertThat(libraries).doesNotContain("libmediasoupclient_so.so")
+    }
+
+    @Test
+    fun mediaEntryPointsThrow() {
+        val transport = TestEnvironment.createRecvTransport(device)
+        try {
+            assertThrows(MediasoupException::class.java) {
+                transport.consume(
+                    listener = TestEnvironment.ConsumerListener,
+                    id = "consumer",
+                    producerId = "producer",
+                    kind = "audio",
+                    rtpParameters = FakeParameters.audioConsumerRtpParameters(0),
+                )
+            }
+            assertThrows(MediasoupException::class.java) {
+                transport.createActiveSpeakerDetector(object : ActiveSpeakerDetector.Listener {
+                    override fun onActiveSpeakerChange(consumerId: String?, audioLevel: Int) = Unit
+                })
+            }
+        } finally {
+            transport.dispose()
+        }
+    }
+}
@@ -0,0 +1,75 @@
+package io.github.crow_misia.mediasoup
+
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import com.google.common.truth.Truth.assertThat
+import org.json.JSONObject
+import org.junit.After
+import org.junit.Assert.assertThrows
+import org.junit.Before
+import org.junit.Test
+import org.junit.runner.RunWith
+import org.webrtc.AudioSource
+import org.webrtc.AudioTrack
+import org.webrtc.MediaConstraints
+import org.webrtc.PeerConnectionFactory
+import org.webrtc.RtpParameters
+
+@RunWith(AndroidJUnit4::class)
+class ProducerTest {
+    private lateinit var factory: PeerConnectionFactory
+    private lateinit var device: Device
+    private lateinit var audioSource: AudioSource
+    private lateinit var audioTrack: AudioTrack
+    private lateinit var transport: SendTransport
+
+    @Before
+    fun setUp() {
+        factory = TestEnvironment.createPeerConnectionFactory()
+        device = TestEnvironment.createLoadedDevice(factory)
+        audioSource = factory.createAudioSource(MediaConstraints())
+        audioTrack = factory.createAudioTrack("audio", audioSource)
+        transport = TestEnvironment.createSendTransport(device)
+    }
+
+    @After
+    fun tearDown() {
+        transport.dispose()
+        audioTrack.dispose()
+        audioSource.dispose()
+        device.dispose()
+        factory.dispose()
+    }
+
+    @Test
+    fun setEncodingsAppliesWithoutNegotiation() {
+        val producer = transport.produce(TestEnvironment.ProducerListener, audioTrack)
+        try {
+            val negotiations = JSONObject(device.usage).getLong("negotiations")
+            val encoding = RtpParameters.Encoding(null, true, null).apply {
+                maxBitrateBps = 32_000
+            }
+
+            producer.setEncodings(listOf(encoding))
+
+            val applied = producer.rtpSender.parameters.encodings
+            assertThat(applied).hasSize(1)
+            assertThat(applied[0].maxBitrateBps).isEqualTo(32_000)
+            assertThat(JSONObject(device.usage).getLong("negotiations")).isEqualTo(negotiations)
+        } finally {
+            producer.dispose()
+        }
+    }
+
+    @Test
+    fun setEncodingsRejectsAnotherLayerCount() {
+        val producer = transport.produce(TestEnvironment.ProducerListener, audioTrack)
+        try {
+            val encodings = List(2) { RtpParameters.Encoding(null, true, null) }
+
+            assertThrows(MediasoupException::class.java) { producer.setEncodings(encodings) }
+            assertThat(producer.rtpSender.parameters.encodings[0].maxBitrateBps).isNull()
+        } finally {
+            producer.dispose()
+        }
+    }
+}
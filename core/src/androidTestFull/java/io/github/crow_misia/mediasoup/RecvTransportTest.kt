@@ -0,0 +1,107 @@
+package io.github.crow_misia.mediasoup
+
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import com.google.common.truth.Truth.assertThat
+import org.json.JSONObject
+import org.junit.After
+import org.junit.Assert.assertThrows
+import org.junit.Before
+import org.junit.Test
+import org.junit.runner.RunWith
+import org.webrtc.PeerConnectionFactory
+
+@RunWith(AndroidJUnit4::class)
+class RecvTransportTest {
+    private lateinit var factory: PeerConnectionFactory
+    private lateinit var device: Device
+    private lateinit var transport: RecvTransport
+
+    @Before
+    fun setUp() {
+        factory = TestEnvironment.createPeerConnectionFactory()
+        device = TestEnvironment.createLoadedDevice(factory)
+        transport = TestEnvironment.createRecvTransport(device)
+    }
+
+    @After
+    fun tearDown() {
+        transport.dispose()
+        device.dispose()
+        factory.dispose()
+    }
+
+    private fun consumeAudio(index: Int): Consumer {
+        return transport.consume(
+            listener = TestEnvironment.ConsumerListener,
+            id = "consumer$index",
+            producerId = "producer$index",
+            kind = "audio",
+            rtpParameters = FakeParameters.audioConsumerRtpParameters(index),
+        )
+    }
+
+    private fun swapAudio(consumer: Consumer, index: Int): Consumer {
+        return transport.swapConsumer(
+            consumer = consumer,
+            listener = TestEnvironment.ConsumerListener,
+            id = "consumer$index",
+            producerId = "producer$index",
+            kind = "audio",
+            rtpParameters = FakeParameters.audioConsumerRtpParameters(index),
+        )
+    }
+
+    @Test
+    fun swapConsumerTakesOverTheMediaSection() {
+        val consumer = consumeAudio(0)
+
+        val swapped = swapAudio(consumer, 1)
+
+        assertThat(consumer.closed).isTrue()
+        assertThat(swapped.closed).isFalse()
+        assertThat(swapped.id).isEqualTo("consumer1")
+        assertThat(swapped.localId).isEqualTo(consumer.localId)
+
+        consumer.dispose()
+        assertThat(JSONObject(device.usage).getInt("consumers")).isEqualTo(1)
+        swapped.dispose()
+    }
+
+    @Test
+    fun swapConsumerRepeatedlyKeepsOneMediaSection() {
+        var consumer = consumeAudio(0)
+        val mid = consumer.localId
+
+        repeat(10) {
+            val swapped = swapAudio(consumer, it + 1)
+            consumer.dispose()
+            consumer = swapped
+            assertThat(consumer.localId).isEqualTo(mid)
+        }
+
+        // A fresh consume has to take a new m-section, as the only one is in use.
+        val other = consumeAudio(100)
+        assertThat(other.localId).isNotEqualTo(mid)
+
+        other.dispose()
+        consumer.dispose()
+    }
+
+    @Test
+    fun swapConsumerOfAnotherTransportFails() {
+        val otherTransport = TestEnvironment.createRecvTransport(device, "other")
+        val consumer = otherTransport.consume(
+            listener = TestEnvironment.ConsumerListener,
+            id = "consumer0",
+            producerId = "producer0",
+            kind = "audio",
+            rtpParameters = FakeParameters.audioConsumerRtpParameters(0),
+        )
+
+        assertThrows(MediasoupException::class.java) { swapAudio(consumer, 1) }
+        assertThat(consumer.closed).isFalse()
+
+        consumer.dispose()
+        otherTransport.dispose()
+    }
+}
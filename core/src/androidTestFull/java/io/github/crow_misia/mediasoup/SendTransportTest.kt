@@ -0,0 +1,67 @@
+package io.github.crow_misia.mediasoup
+
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import com.google.common.truth.Truth.assertThat
+import org.junit.After
+import org.junit.Before
+import org.junit.Test
+import org.junit.runner.RunWith
+import org.webrtc.AudioSource
+import org.webrtc.AudioTrack
+import org.webrtc.MediaConstraints
+import org.webrtc.PeerConnectionFactory
+import java.util.concurrent.TimeUnit
+import kotlin.concurrent.thread
+
+@RunWith(AndroidJUnit4::class)
+class SendTransportTest {
+    private lateinit var factory: PeerConnectionFactory
+    private lateinit var device: Device
+    private lateinit var audioSource: AudioSource
+    private lateinit var audioTrack: AudioTrack
+
+    @Before
+    fun setUp() {
+        factory = TestEnvironment.createPeerConnectionFactory()
+        device = TestEnvironment.createLoadedDevice(factory)
+        audioSource = factory.createAudioSource(MediaConstraints())
+        audioTrack = factory.createAudioTrack("audio", audioSource)
+    }
+
+    @After
+    fun tearDown() {
+        audioTrack.dispose()
+        audioSource.dispose()
+        device.dispose()
+        factory.dispose()
+    }
+
+    @Test
+    fun transportIsUsableFromAnotherThreadWhileOnProduceWaits() {
+        var statsRead = false
+        val listener = object : SendTransport.Listener by TestEnvironment.SendTransportListener {
+            override fun onProduce(transport: Transport, kind: String, rtpParameters: String, appData: String?): String {
+                // As when the signaling of the app needs the transport before answering.
+                val other = thread { transport.stats }
+                other.join(TimeUnit.SECONDS.toMillis(5))
+                statsRead = !other.isAlive
+                return "producer0"
+            }
+        }
+        val transport = device.createSendTransport(
+            listener = listener,
+            id = "send",
+            iceParameters = FakeParameters.ICE_PARAMETERS,
+            iceCandidates = FakeParameters.ICE_CANDIDATES,
+            dtlsParameters = FakeParameters.DTLS_PARAMETERS,
+        )
+
+        val producer = transport.produce(TestEnvironment.ProducerListener, audioTrack)
+
+        assertThat(statsRead).isTrue()
+        assertThat(producer.id).isEqualTo("producer0")
+
+        producer.dispose()
+        transport.dispose()
+    }
+}
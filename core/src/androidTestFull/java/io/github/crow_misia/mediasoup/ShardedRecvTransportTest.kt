@@ -0,0 +1,161 @@
+package io.github.crow_misia.mediasoup
+
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import com.google.common.truth.Truth.assertThat
+import org.junit.After
+import org.junit.Assert.assertThrows
+import org.junit.Before
+import org.junit.Test
+import org.junit.runner.RunWith
+import org.webrtc.PeerConnectionFactory
+
+@RunWith(AndroidJUnit4::class)
+class ShardedRecvTransportTest {
+    private lateinit var factory: PeerConnectionFactory
+    private lateinit var device: Device
+
+    @Before
+    fun setUp() {
+        factory = TestEnvironment.createPeerConnectionFactory()
+        device = TestEnvironment.createLoadedDevice(factory)
+    }
+
+    @After
+    fun tearDown() {
+        device.dispose()
+        factory.dispose()
+    }
+
+    @Test
+    fun byCountSpreadsConsumers() {
+        val sharded = createSharded(ShardedRecvTransport.Placement.BY_COUNT)
+        val consumers = List(6) { consumeAudio(sharded, it) }
+
+        assertThat(sharded.consumerCounts.toList()).containsExactly(2, 2, 2)
+        consumers.forEach { assertThat(sharded.transportOf(it)).isNotNull() }
+
+        sharded.closeConsumer(consumers[0])
+        assertThat(sharded.consumerCounts.sum()).isEqualTo(5)
+        assertThat(sharded.transportOf(consumers[0])).isNull()
+
+        consumers.forEach { it.dispose() }
+        sharded.dispose()
+    }
+
+    @Test
+    fun byKindKeepsAudioOnTheFirstShard() {
+        val sharded = createSharded(ShardedRecvTransport.Placement.BY_KIND)
+        val consumers = List(3) { consumeAudio(sharded, it) }
+
+        assertThat(sharded.consumerCounts.toList()).containsExactly(3, 0, 0).inOrder()
+        consumers.forEach { assertThat(sharded.transportOf(it)).isSameInstanceAs(sharded.transports[0]) }
+
+        consumers.forEach { it.dispose() }
+        sharded.dispose()
+    }
+
+    @Test
+    fun swapConsumerStaysOnItsShard() {
+        val sharded = createSharded(ShardedRecvTransport.Placement.BY_COUNT)
+        val consumer = consumeAudio(sharded, 0)
+        val transport = sharded.transportOf(consumer)
+
+        val swapped = sharded.swapConsumer(
+            consumer = consumer,
+            listener = TestEnvironment.ConsumerListener,
+            id = "consumer1",
+            producerId = "producer1",
+            kind = "audio",
+            rtpParameters = FakeParameters.audioConsumerRtpParameters(1),
+        )
+
+        assertThat(sharded.transportOf(swapped)).isSameInstanceAs(transport)
+        assertThat(sharded.transportOf(consumer)).isNull()
+        assertThat(sharded.consumerCounts.sum()).isEqualTo(1)
+
+        consumer.dispose()
+        swapped.dispose()
+        sharded.dispose()
+    }
+
+    @Test
+    fun failedSwapAfterTheCloseGivesUpThePlace() {
+        val sharded = createSharded(ShardedRecvTransport.Placement.BY_COUNT)
+        val consumer = consumeAudio(sharded, 0)
+
+        assertThrows(MediasoupException::class.java) {
+            sharded.swapConsumer(
+                consumer = consumer,
+                listener = TestEnvironment.ConsumerListener,
+                id = "consumer1",
+                producerId = "producer1",
+                kind = "audio",
+                rtpParameters = "{}",
+            )
+        }
+
+        assertThat(consumer.closed).isTrue()
+        assertThat(sharded.consumerCounts.sum()).isEqualTo(0)
+        assertThat(sharded.transportOf(consumer)).isNull()
+
+        consumer.dispose()
+        sharded.dispose()
+    }
+
+    @Test
+    fun swapOfADisposedConsumerKeepsItsPlace() {
+        val sharded = createSharded(ShardedRecvTransport.Placement.BY_COUNT)
+        val consumer = consumeAudio(sharded, 0)
+        val transport = sharded.transportOf(consumer)
+        consumer.dispose()
+
+        assertThrows(IllegalStateException::class.java) {
+            sharded.swapConsumer(
+                consumer = consumer,
+                listener = TestEnvironment.ConsumerListener,
+                id = "consumer1",
+                producerId = "producer1",
+                kind = "audio",
+                rtpParameters = FakeParameters.audioConsumerRtpParameters(1),
+            )
+        }
+
+        assertThat(sharded.transportOf(consumer)).isSameInstanceAs(transport)
+        assertThat(sharded.consumerCounts.sum()).isEqualTo(1)
+
+        sharded.dispose()
+    }
+
+    @Test
+    fun closeResetsCounts() {
+        val sharded = createSharded(ShardedRecvTransport.Placement.BY_COUNT)
+        val consumers = List(3) { consumeAudio(sharded, it) }
+
+        sharded.close()
+
+        assertThat(sharded.consumerCounts.sum()).isEqualTo(0)
+        consumers.forEach { assertThat(it.closed).isTrue() }
+
+        consumers.forEach { it.dispose() }
+        sharded.dispose()
+    }
+
+    private fun createSharded(placement: ShardedRecvTransport.Placement): ShardedRecvTransport {
+        val transports = List(SHARDS) { TestEnvironment.createRecvTransport(device, "recv$it") }
+        return ShardedRecvTransport(transports, placement)
+    }
+
+    private fun consumeAudio(sharded: ShardedRecvTransport, index: Int): Consumer {
+        return sharded.consume(
+            listener = TestEnvironment.ConsumerListener,
+            id = "consumer$index",
+            producerId = "producer$index",
+            kind = "audio",
+            rtpParameters = FakeParameters.audioConsumerRtpParameters(index),
+        )
+    }
+
+    private companion object {
+        const val SHARDS = 3
+    }
+}
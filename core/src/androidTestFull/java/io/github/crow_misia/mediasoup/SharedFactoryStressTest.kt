@@ -0,0 +1,81 @@
+package io.github.crow_misia.mediasoup
+
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import com.google.common.truth.Truth.assertThat
+import org.json.JSONObject
+import org.junit.After
+import org.junit.Before
+import org.junit.Test
+import org.junit.runner.RunWith
+import org.webrtc.PeerConnectionFactory
+import java.util.concurrent.CountDownLatch
+import java.util.concurrent.Executors
+import java.util.concurrent.TimeUnit
+
+/**
+ * Devices sharing one PeerConnectionFactory, and so its signaling thread, negotiating at the same time.
+ */
+@RunWith(AndroidJUnit4::class)
+class SharedFactoryStressTest {
+    private lateinit var factory: PeerConnectionFactory
+
+    @Before
+    fun setUp() {
+        factory = TestEnvironment.createPeerConnectionFactory()
+    }
+
+    @After
+    fun tearDown() {
+        factory.dispose()
+    }
+
+    @Test
+    fun devicesOnOneFactoryNegotiateConcurrently() {
+        val devices = List(DEVICES) { TestEnvironment.createLoadedDevice(factory) }
+        val executor = Executors.newFixedThreadPool(DEVICES)
+        val start = CountDownLatch(1)
+        try {
+            val results = devices.mapIndexed { deviceIndex, device ->
+                executor.submit<List<Consumer>> {
+                    start.await()
+                    val transport = TestEnvironment.createRecvTransport(device, "recv$deviceIndex")
+                    List(CONSUMES) {
+                        val index = deviceIndex * CONSUMES + it
+                        transport.consume(
+                            listener = TestEnvironment.ConsumerListener,
+                            id = "consumer$index",
+                            producerId = "producer$index",
+                            kind = "audio",
+                            rtpParameters = FakeParameters.audioConsumerRtpParameters(index),
+                        )
+                    }
+                }
+            }
+            start.countDown()
+            val consumers = results.map { it.get(60, TimeUnit.SECONDS) }
+
+            // Each Device only accounts what was created from it.
+            devices.forEach {
+                val usage = JSONObject(it.usage)
+                assertThat(usage.getInt("recvTransports")).isEqualTo(1)
+                assertThat(usage.getInt("consumers")).isEqualTo(CONSUMES)
+                assertThat(usage.getLong("negotiations")).isAtLeast(CONSUMES.toLong())
+            }
+            consumers.forEach { perDevice ->
+                assertThat(perDevice.map { it.localId }.toSet()).hasSize(CONSUMES)
+            }
+            assertThat(factory.measureQueueDelay()).isAtLeast(0L)
+
+            consumers.flatten().forEach { it.dispose() }
+            devices.forEach { assertThat(JSONObject(it.usage).getInt("consumers")).isEqualTo(0) }
+        } finally {
+            executor.shutdown()
+            devices.forEach { it.dispose() }
+        }
+    }
+
+    private companion object {
+        const val DEVICES = 4
+        const val CONSUMES = 10
+    }
+}
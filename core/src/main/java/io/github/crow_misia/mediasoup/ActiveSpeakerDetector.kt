@@ -0,0 +1,38 @@
+package io.github.crow_misia.mediasoup
+
+import org.webrtc.CalledByNative
+
+/**
+ * Dominant speaker among the audio consumers of a RecvTransport, see [RecvTransport.createActiveSpeakerDetector].
+ *
+ * Audio levels are read from the RTP receivers, so the producers must send the ssrc-audio-level header extension.
+ */
+class ActiveSpeakerDetector internal constructor(
+    private var nativeDetector: Long,
+) {
+    interface Listener {
+        /**
+         * The dominant speaker changed. Called on the detector thread.
+         * Do not dispose the detector from here.
+         *
+         * @param consumerId Consumer of the new speaker, or null when the previous one went away and nobody speaks.
+         * @param audioLevel smoothed level of the new speaker in dBov (-127..0).
+         */
+        @CalledByNative("Listener")
+        fun onActiveSpeakerChange(consumerId: String?, audioLevel: Int)
+    }
+
+    /**
+     * Stop detecting.
+     */
+    fun dispose() {
+        val ptr = nativeDetector
+        if (ptr == 0L) {
+            return
+        }
+        nativeDetector = 0L
+        nativeDispose(ptr)
+    }
+
+    private external fun nativeDispose(nativeDetector: Long)
+}
@@ -0,0 +1,83 @@
+package io.github.crow_misia.mediasoup
+
+import java.nio.ByteBuffer
+
+/**
+ * Decoded audio of a remote track, see [Consumer.addAudioSink].
+ *
+ * Frames are 10 ms of 16 bit interleaved PCM in native byte order.
+ * The audio thread never waits for the reader: when the ring is full new frames are dropped.
+ */
+class AudioSink internal constructor(
+    private var nativeAudioSink: Long,
+    val sampleRate: Int,
+    val channels: Int,
+) {
+    /**
+     * Bytes in one frame.
+     */
+    val frameSize: Int = sampleRate / 100 * channels * Short.SIZE_BYTES
+
+    /**
+     * Frames waiting to be read.
+     */
+    val availableFrames: Int
+        get() {
+            checkAudioSinkExists()
+            return nativeGetAvailableFrames(nativeAudioSink)
+        }
+
+    /**
+     * Frames dropped because the ring was full.
+     */
+    val droppedFrames: Long
+        get() {
+            checkAudioSinkExists()
+            return nativeGetDroppedFrames(nativeAudioSink)
+        }
+
+    /**
+     * Handle for mediasoup_audio_sink_read() of mediasoup_native.h.
+     * Valid until [dispose] is called.
+     */
+    val nativeHandle: Long
+        get() {
+            checkAudioSinkExists()
+            return nativeAudioSink
+        }
+
+    /**
+     * Copy as many whole frames as fit in the remaining space of a direct [buffer] and advance its position.
+     * Never blocks. Only one thread may read at a time.
+     *
+     * @return number of frames copied.
+     */
+    fun read(buffer: ByteBuffer): Int {
+        checkAudioSinkExists()
+        require(buffer.isDirect) { "buffer must be direct" }
+        val frames = nativeRead(nativeAudioSink, buffer, buffer.position(), buffer.remaining())
+        buffer.position(buffer.position() + frames * frameSize)
+        return frames
+    }
+
+    /**
+     * Detach from the track and release the ring.
+     */
+    fun dispose() {
+        val ptr = nativeAudioSink
+        if (ptr == 0L) {
+            return
+        }
+        nativeAudioSink = 0L
+        nativeDispose(ptr)
+    }
+
+    private fun checkAudioSinkExists() {
+        check(nativeAudioSink != 0L) { "AudioSink has been disposed." }
+    }
+
+    private external fun nativeRead(nativeAudioSink: Long, buffer: ByteBuffer, offset: Int, length: Int): Int
+    private external fun nativeGetAvailableFrames(nativeAudioSink: Long): Int
+    private external fun nativeGetDroppedFrames(nativeAudioSink: Long): Long
+    private external fun nativeDispose(nativeAudioSink: Long)
+}
@@ -125,6 +125,55 @@ class Consumer @CalledByNative private constructor(
         nativePause(nativeConsumer)
     }
 
+    internal val nativeHandle: Long
+        get() {
+            checkConsumerExists()
+            return nativeConsumer
+        }
+
+    /**
+     * Tap the decoded audio of this Consumer.
+     * The sink keeps receiving audio until it is disposed, also after the Consumer is disposed.
+     *
+     * @param sampleRate sample rate of the frames, 8000..48000 Hz.
+     * @param channels 1 to downmix, or 2.
+     * @param capacityFrames number of 10 ms frames buffered before new ones are dropped.
+     */
+    @JvmOverloads
+    fun addAudioSink(
+        sampleRate: Int = 16000,
+        channels: Int = 1,
+        capacityFrames: Int = 100,
+    ): AudioSink {
+        checkConsumerExists()
+        require(sampleRate in 8000..48000 && sampleRate % 100 == 0) { "unsupported sampleRate" }
+        require(channels in 1..2) { "channels must be 1 or 2" }
+        require(capacityFrames > 0) { "capacityFrames must be positive" }
+        val nativeAudioSink = nativeAddAudioSink(nativeConsumer, sampleRate, channels, capacityFrames)
+        return AudioSink(nativeAudioSink, sampleRate, channels)
+    }
+
+    /**
+     * Tap downscaled frames of this Consumer, for thumbnail grids.
+     * The sink keeps receiving frames until it is disposed, also after the Consumer is disposed.
+     *
+     * @param maxWidth maximum thumbnail width; the aspect ratio is kept and frames are never upscaled.
+     * @param maxHeight maximum thumbnail height.
+     * @param maxFramerate maximum thumbnails per second, or 0 for every frame.
+     */
+    @JvmOverloads
+    fun addThumbnailSink(
+        maxWidth: Int,
+        maxHeight: Int,
+        maxFramerate: Int = 15,
+    ): VideoThumbnailSink {
+        checkConsumerExists()
+        require(maxWidth >= 2 && maxHeight >= 2) { "thumbnail size must be at least 2x2" }
+        require(maxFramerate >= 0) { "maxFramerate must not be negative" }
+        val nativeThumbnailSink = nativeAddThumbnailSink(nativeConsumer, maxWidth, maxHeight, maxFramerate)
+        return VideoThumbnailSink(nativeThumbnailSink)
+    }
+
     /**
      * Closes the Consumer.
      */
@@ -164,4 +213,6 @@ class Consumer @CalledByNative private constructor(
     private external fun nativePause(nativeConsumer: Long)
     private external fun nativeResume(nativeConsumer: Long)
     private external fun nativeDispose(nativeConsumer: Long)
+    private external fun nativeAddAudioSink(nativeConsumer: Long, sampleRate: Int, channels: Int, capacityFrames: Int): Long
+    private external fun nativeAddThumbnailSink(nativeConsumer: Long, maxWidth: Int, maxHeight: Int, maxFramerate: Int): Long
 }
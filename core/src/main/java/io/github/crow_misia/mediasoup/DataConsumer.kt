@@ -104,6 +104,16 @@ class DataConsumer @CalledByNative private constructor(
         nativeGetAppData(nativeDataConsumer)
     }
 
+    /**
+     * Handle for mediasoup_data_consumer_set_listener() of mediasoup_native.h.
+     * Valid until [dispose] is called.
+     */
+    val nativeHandle: Long
+        get() {
+            checkDataConsumerExists()
+            return nativeDataConsumer
+        }
+
     /**
      * Closes the DataConsumer.
      */
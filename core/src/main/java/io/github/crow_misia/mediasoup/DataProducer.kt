@@ -98,6 +98,16 @@ class DataProducer @CalledByNative private constructor(
         nativeClose(nativeDataProducer)
     }
 
+    /**
+     * Handle for mediasoup_data_producer_send() of mediasoup_native.h.
+     * Valid until [dispose] is called.
+     */
+    val nativeHandle: Long
+        get() {
+            checkDataProducerExists()
+            return nativeDataProducer
+        }
+
     /**
      * Send data.
      */
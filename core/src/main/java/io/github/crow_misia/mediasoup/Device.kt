@@ -5,11 +5,16 @@ import org.webrtc.PeerConnectionFactory
 
 /**
  * Device.
+ *
+ * @param opaqueAppData keep the appData given to transports, producers and consumers as the string itself.
+ * It is returned by appData and passed to the produce listeners as given, without being parsed
+ * and serialized again, and is not checked to be valid JSON.
  */
-class Device(
+class Device @JvmOverloads constructor(
     private val peerConnectionFactory: PeerConnectionFactory,
+    opaqueAppData: Boolean = false,
 ) {
-    private var nativeDevice: Long = nativeNewDevice()
+    private var nativeDevice: Long = nativeNewDevice(opaqueAppData)
 
     val loaded: Boolean
         get() {
@@ -27,13 +32,35 @@ class Device(
         nativeGetSctpCapabilities(nativeDevice)
     }
 
+    /**
+     * Live transports, producers and consumers of this Device and the time spent negotiating, as JSON.
+     * Devices sharing a PeerConnectionFactory are accounted separately.
+     */
+    val usage: String
+        get() {
+            checkDeviceExists()
+            return nativeGetUsage(nativeDevice)
+        }
+
+    /**
+     * Use pre-generated DTLS certificates for the transports created from now on, and for [load].
+     * Certificates set in the RTCConfiguration take precedence. Null stops using the provider.
+     */
+    fun setCertificateProvider(provider: DtlsCertificateProvider?) {
+        checkDeviceExists()
+        nativeSetCertificateProvider(nativeDevice, provider?.nativeHandle ?: 0L)
+    }
+
     /**
      * Initialize the Device.
+     *
+     * @param capabilityFilter prunes [routerRtpCapabilities] before they are used.
      */
     @JvmOverloads
     fun load(
         routerRtpCapabilities: String,
         rtcConfig: PeerConnection.RTCConfiguration? = null,
+        capabilityFilter: RtpCapabilityFilter? = null,
     ) {
         checkDeviceExists()
         nativeLoad(
@@ -41,9 +68,24 @@ class Device(
             routerRtpCapabilities = routerRtpCapabilities,
             rtcConfig = rtcConfig,
             peerConnectionFactory = peerConnectionFactory.nativePeerConnectionFactory,
+            mimeTypes = capabilityFilter?.mimeTypes?.toTypedArray(),
+            headerExtensions = capabilityFilter?.headerExtensions?.toTypedArray(),
+            rtcpFeedback = capabilityFilter?.rtcpFeedback?.toTypedArray(),
         )
     }
 
+    /**
+     * Initialize the Device for DataProducers and DataConsumers only, without the router RTP capabilities.
+     * No media section is negotiated on its transports, and produce / consume fail right away.
+     * Media engines belong to the PeerConnectionFactory, which can be built without audio device module
+     * and video codec factories for such a Device. The "data" flavor ships only this part of the bridge.
+     */
+    @JvmOverloads
+    fun loadDataOnly(rtcConfig: PeerConnection.RTCConfiguration? = null) {
+        checkDeviceExists()
+        nativeLoadDataOnly(nativeDevice, rtcConfig, peerConnectionFactory.nativePeerConnectionFactory)
+    }
+
     /**
      * Whether we can produce audio/video.
      */
@@ -52,8 +94,21 @@ class Device(
         return nativeCanProduce(nativeDevice, kind)
     }
 
+    /**
+     * Codec capability of the loaded Device with the given mime type, such as "video/H264", as JSON.
+     * Can be passed as codec to [SendTransport.produce]. Null when the codec is not supported.
+     */
+    fun findCodec(mimeType: String): String? {
+        checkDeviceExists()
+        return nativeFindCodec(nativeDevice, mimeType)
+    }
+
     /**
      * Create a new Transport.
+     *
+     * @param factory factory of the transport PeerConnection, whose signaling thread runs its negotiations,
+     * see [PeerConnectionFactoryPool]. The factory of this Device when null.
+     * Tracks produced on the transport must come from the same factory.
      */
     @JvmOverloads
     fun createSendTransport(
@@ -65,6 +120,7 @@ class Device(
         sctpParameters: String? = null,
         rtcConfig: PeerConnection.RTCConfiguration? = null,
         appData: String? = null,
+        factory: PeerConnectionFactory? = null,
     ): SendTransport {
         checkDeviceExists()
         return nativeCreateSendTransport(
@@ -76,13 +132,16 @@ class Device(
             dtlsParameters = dtlsParameters,
             sctpParameters = sctpParameters,
             rtcConfig = rtcConfig,
-            peerConnectionFactory = peerConnectionFactory.nativePeerConnectionFactory,
+            peerConnectionFactory = (factory ?: peerConnectionFactory).nativePeerConnectionFactory,
             appData = appData,
         )
     }
 
     /**
      * Create a new Transport.
+     *
+     * @param factory factory of the transport PeerConnection, whose signaling thread runs its negotiations,
+     * see [PeerConnectionFactoryPool]. The factory of this Device when null.
      */
     @JvmOverloads
     fun createRecvTransport(
@@ -94,6 +153,7 @@ class Device(
         sctpParameters: String? = null,
         rtcConfig: PeerConnection.RTCConfiguration? = null,
         appData: String? = null,
+        factory: PeerConnectionFactory? = null,
     ): RecvTransport {
         checkDeviceExists()
         return nativeCreateRecvTransport(
@@ -105,7 +165,7 @@ class Device(
             dtlsParameters = dtlsParameters,
             sctpParameters = sctpParameters,
             rtcConfig = rtcConfig,
-            peerConnectionFactory = peerConnectionFactory.nativePeerConnectionFactory,
+            peerConnectionFactory = (factory ?: peerConnectionFactory).nativePeerConnectionFactory,
             appData = appData,
         )
     }
@@ -123,8 +183,9 @@ class Device(
         check(nativeDevice != 0L) { "Device has been disposed." }
     }
 
-    private external fun nativeNewDevice(): Long
+    private external fun nativeNewDevice(opaqueAppData: Boolean): Long
     private external fun nativeDispose(nativeDevice: Long)
+    private external fun nativeGetUsage(nativeDevice: Long): String
     private external fun nativeIsLoaded(nativeDevice: Long): Boolean
     private external fun nativeGetRtpCapabilities(nativeDevice: Long): String
     private external fun nativeGetSctpCapabilities(nativeDevice: Long): String
@@ -133,8 +194,18 @@ class Device(
         routerRtpCapabilities: String,
         rtcConfig: PeerConnection.RTCConfiguration?,
         peerConnectionFactory: Long,
+        mimeTypes: Array<String>?,
+        headerExtensions: Array<String>?,
+        rtcpFeedback: Array<String>?,
+    )
+    private external fun nativeSetCertificateProvider(nativeDevice: Long, nativeProvider: Long)
+    private external fun nativeLoadDataOnly(
+        nativeDevice: Long,
+        rtcConfig: PeerConnection.RTCConfiguration?,
+        peerConnectionFactory: Long,
     )
     private external fun nativeCanProduce(nativeDevice: Long, kind: String): Boolean
+    private external fun nativeFindCodec(nativeDevice: Long, mimeType: String): String?
     private external fun nativeCreateSendTransport(
         nativeDevice: Long,
         listener: SendTransport.Listener,
@@ -162,6 +233,6 @@ class Device(
     ): RecvTransport
 }
 
-fun PeerConnectionFactory.createDevice(): Device {
-    return Device(this)
+fun PeerConnectionFactory.createDevice(opaqueAppData: Boolean = false): Device {
+    return Device(this, opaqueAppData)
 }
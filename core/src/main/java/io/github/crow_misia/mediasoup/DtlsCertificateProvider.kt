@@ -0,0 +1,86 @@
+package io.github.crow_misia.mediasoup
+
+import org.webrtc.RtcCertificatePem
+import java.util.concurrent.TimeUnit
+
+/**
+ * ECDSA DTLS certificates generated ahead of time on a background thread and reused by the transports
+ * of the Devices it is set on, see [Device.setCertificateProvider].
+ *
+ * A certificate is reused while it has more than a quarter of [lifetimeMs] left, and the next one is
+ * generated in the background once it is past half of it.
+ * Reusing a certificate makes its fingerprint identify the client across sessions, pick the lifetime accordingly.
+ *
+ * @param lifetimeMs validity of the generated certificates, at least one second. Capped at one year,
+ * the longest WebRTC generates.
+ */
+class DtlsCertificateProvider @JvmOverloads constructor(
+    lifetimeMs: Long = TimeUnit.DAYS.toMillis(7),
+) {
+    private var nativeProvider: Long
+
+    init {
+        require(lifetimeMs >= MIN_LIFETIME_MS) { "lifetimeMs must be at least one second" }
+        nativeProvider = nativeNew(lifetimeMs.coerceAtMost(MAX_LIFETIME_MS))
+    }
+
+    internal val nativeHandle: Long
+        get() {
+            checkProviderExists()
+            return nativeProvider
+        }
+
+    /**
+     * Counters as JSON: generated, reused, waits (transport creations that waited for a generation),
+     * lastGenerationMillis and expiresMillis of the current certificate.
+     */
+    val metrics: String
+        get() {
+            checkProviderExists()
+            return nativeGetMetrics(nativeProvider)
+        }
+
+    /**
+     * The current certificate, to be saved and given to [importPem] after a restart.
+     * Waits for the first generation. Null when it failed.
+     */
+    fun exportPem(): RtcCertificatePem? {
+        checkProviderExists()
+        return nativeExportPem(nativeProvider)?.let { RtcCertificatePem(it[0], it[1]) }
+    }
+
+    /**
+     * Reuse a saved certificate. Ignored when it has expired or the current one lasts longer.
+     */
+    fun importPem(pem: RtcCertificatePem) {
+        checkProviderExists()
+        nativeImportPem(nativeProvider, pem.privateKey, pem.certificate)
+    }
+
+    /**
+     * Dispose the provider. Devices it is set on keep using it.
+     */
+    fun dispose() {
+        val ptr = nativeProvider
+        if (ptr == 0L) {
+            return
+        }
+        nativeProvider = 0L
+        nativeDispose(ptr)
+    }
+
+    private fun checkProviderExists() {
+        check(nativeProvider != 0L) { "DtlsCertificateProvider has been disposed." }
+    }
+
+    private companion object {
+        val MIN_LIFETIME_MS = TimeUnit.SECONDS.toMillis(1)
+        val MAX_LIFETIME_MS = TimeUnit.DAYS.toMillis(365)
+    }
+
+    private external fun nativeNew(lifetimeMs: Long): Long
+    private external fun nativeExportPem(nativeProvider: Long): Array<String>?
+    private external fun nativeImportPem(nativeProvider: Long, privateKey: String, certificate: String)
+    private external fun nativeGetMetrics(nativeProvider: Long): String
+    private external fun nativeDispose(nativeProvider: Long)
+}
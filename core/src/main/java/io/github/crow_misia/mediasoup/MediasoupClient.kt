@@ -15,7 +15,7 @@ object MediasoupClient {
         useTracer: Boolean = false,
         fieldTrials: String? = null,
         loggableSeverity: Logging.Severity = Logging.Severity.LS_NONE,
-        nativeLibraryName: String = "mediasoupclient_so",
+        nativeLibraryName: String = BuildConfig.NATIVE_LIBRARY_NAME,
     ) {
         WebRtcLogger.setHandler(logHandler)
 
@@ -0,0 +1,31 @@
+package io.github.crow_misia.mediasoup
+
+/**
+ * Latency and allocation statistics of the native negotiation steps
+ * (Device.load, SendTransport.produce, RecvTransport.consume, ...).
+ */
+object NegotiationStats {
+    /**
+     * Statistics per operation as a JSON object.
+     * Empty unless the native library is built with MEDIASOUPCLIENT_NEGOTIATION_STATS.
+     *
+     * Each operation has count, totalMicros, meanMicros, maxMicros, heapAllocations and maxHeapAllocations.
+     * Heap allocations are only counted when the native library is built with
+     * MEDIASOUPCLIENT_ALLOC_STATS, and are 0 otherwise.
+     */
+    val stats: String
+        get() = nativeGetStats()
+
+    /**
+     * Clear all recorded statistics.
+     */
+    fun reset() {
+        nativeReset()
+    }
+
+    @JvmStatic
+    private external fun nativeGetStats(): String
+
+    @JvmStatic
+    private external fun nativeReset()
+}
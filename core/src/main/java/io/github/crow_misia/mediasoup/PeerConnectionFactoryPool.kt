@@ -0,0 +1,68 @@
+package io.github.crow_misia.mediasoup
+
+import org.webrtc.PeerConnectionFactory
+import java.util.concurrent.atomic.AtomicInteger
+
+/**
+ * PeerConnectionFactories handed out to transports, so that their negotiations run on several
+ * signaling threads instead of queueing on the one of a single factory.
+ * Pass the factory to [Device.createSendTransport] or [Device.createRecvTransport].
+ *
+ * The pool owns the factories and disposes them in [dispose], after every transport using them.
+ *
+ * @param factories the factories, at least one. Each owns its network, worker and signaling threads.
+ */
+class PeerConnectionFactoryPool(factories: List<PeerConnectionFactory>) {
+    /**
+     * The factories, in the order given.
+     */
+    val factories: List<PeerConnectionFactory> = factories.toList()
+
+    private val nextIndex = AtomicInteger()
+
+    init {
+        require(this.factories.isNotEmpty()) { "factories must not be empty" }
+    }
+
+    /**
+     * The next factory, round-robin.
+     */
+    fun next(): PeerConnectionFactory {
+        return factories[Math.floorMod(nextIndex.getAndIncrement(), factories.size)]
+    }
+
+    /**
+     * The factory for [affinity], the same for equal keys. Transports of one room or one
+     * [ShardedRecvTransport] shard can keep their negotiations ordered on one signaling thread this way.
+     */
+    fun forAffinity(affinity: Any): PeerConnectionFactory {
+        return factories[Math.floorMod(affinity.hashCode(), factories.size)]
+    }
+
+    /**
+     * Queue delay of [target] of each factory in microseconds, -1 where it failed,
+     * see [ThreadPolicy.measureQueueDelayMicros].
+     */
+    @JvmOverloads
+    fun measureQueueDelays(target: ThreadPolicy.Target = ThreadPolicy.Target.SIGNALING): LongArray {
+        return LongArray(factories.size) { ThreadPolicy.measureQueueDelayMicros(factories[it], target) }
+    }
+
+    /**
+     * Dispose every factory.
+     */
+    fun dispose() {
+        factories.forEach { it.dispose() }
+    }
+
+    companion object {
+        /**
+         * Create a pool of [size] factories, each built by [create].
+         */
+        @JvmStatic
+        fun create(size: Int, create: () -> PeerConnectionFactory): PeerConnectionFactoryPool {
+            require(size > 0) { "size must be positive" }
+            return PeerConnectionFactoryPool(List(size) { create() })
+        }
+    }
+}
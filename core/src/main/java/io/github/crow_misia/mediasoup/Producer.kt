@@ -3,6 +3,7 @@ package io.github.crow_misia.mediasoup
 import org.webrtc.CalledByNative
 import org.webrtc.MediaStreamTrack
 import org.webrtc.RTCUtils
+import org.webrtc.RtpParameters
 import org.webrtc.RtpSender
 
 class Producer @CalledByNative internal constructor(
@@ -15,6 +16,8 @@ class Producer @CalledByNative internal constructor(
 
     private var cachedTrack: MediaStreamTrack?
 
+    private var simulcastController: SimulcastController? = null
+
     /**
      * Producer ID.
      */
@@ -122,6 +125,40 @@ class Producer @CalledByNative internal constructor(
         cachedTrack = RTCUtils.createMediaStreamTrack(nativeTrack)
     }
 
+    /**
+     * Update maxBitrateBps, maxFramerate, scaleResolutionDownBy, active and networkPriority of all the encodings
+     * at once, without renegotiation. Other fields are ignored.
+     * One encoding per layer, in the order of [rtpSender] parameters, is expected; a rid, when set, must match.
+     * Active flags set here are overridden by a later [maxSpatialLayer] change, and the other way around.
+     */
+    fun setEncodings(encodings: List<RtpParameters.Encoding>) {
+        checkProducerExists()
+        nativeSetEncodings(nativeProducer, encodings.toTypedArray())
+    }
+
+    /**
+     * Start adapting [maxSpatialLayer] of this simulcast video Producer to the available outgoing bitrate
+     * and to CPU overuse of the encoder. The previous controller, if any, is disposed.
+     * [maxSpatialLayer] must not be set while the controller runs.
+     *
+     * @param intervalMs stats sampling interval.
+     * @param headroom share of the available outgoing bitrate the layers may use, by their maxBitrate.
+     * @param downSamples consecutive samples needed to lower the layer.
+     * @param upSamples consecutive samples needed to raise the layer by one.
+     */
+    @JvmOverloads
+    fun createSimulcastController(
+        intervalMs: Int = 1000,
+        headroom: Double = 0.9,
+        downSamples: Int = 2,
+        upSamples: Int = 5,
+    ): SimulcastController {
+        checkProducerExists()
+        simulcastController?.dispose()
+        val nativeController = nativeCreateSimulcastController(nativeProducer, intervalMs, headroom, downSamples, upSamples)
+        return SimulcastController(nativeController).also { simulcastController = it }
+    }
+
     /**
      * Resumes sending media.
      */
@@ -143,6 +180,8 @@ class Producer @CalledByNative internal constructor(
      */
     fun close() {
         checkProducerExists()
+        simulcastController?.dispose()
+        simulcastController = null
         cachedTrack?.dispose()
         cachedTrack = null
         nativeClose(nativeProducer)
@@ -152,6 +191,8 @@ class Producer @CalledByNative internal constructor(
      * Dispose the Producer.
      */
     fun dispose() {
+        simulcastController?.dispose()
+        simulcastController = null
         cachedTrack?.dispose()
         cachedTrack = null
 
@@ -183,5 +224,7 @@ class Producer @CalledByNative internal constructor(
     private external fun nativeResume(nativeProducer: Long)
     private external fun nativeReplaceTrack(nativeProducer: Long, track: Long)
     private external fun nativeSetMaxSpatialLayer(nativeProducer: Long, spatialLayer: Int)
+    private external fun nativeSetEncodings(nativeProducer: Long, encodings: Array<RtpParameters.Encoding>)
+    private external fun nativeCreateSimulcastController(nativeProducer: Long, intervalMs: Int, headroom: Double, downSamples: Int, upSamples: Int): Long
     private external fun nativeDispose(nativeProducer: Long)
 }
@@ -37,6 +37,36 @@ class RecvTransport @CalledByNative private constructor(
         )
     }
 
+    /**
+     * Close [consumer] and create a Consumer in its place, for UIs paging through participants.
+     * The close is negotiated first, so the new Consumer can take over the m-section [consumer] leaves
+     * in a second SDP exchange, and the SDP of this transport does not grow with every page.
+     * [consumer] still has to be disposed, and stays closed when creating the new Consumer fails.
+     * Throws [MediasoupException], leaving [consumer] open, when it does not belong to this transport.
+     */
+    @JvmOverloads
+    fun swapConsumer(
+        consumer: Consumer,
+        listener: Consumer.Listener,
+        id: String,
+        producerId: String,
+        kind: String,
+        rtpParameters: String? = null,
+        appData: String? = null,
+    ): Consumer {
+        checkTransportExists()
+        return nativeSwapConsumer(
+            nativeTransport = nativeTransport,
+            nativeConsumer = consumer.nativeHandle,
+            listener = listener,
+            id = id,
+            producerId = producerId,
+            kind = kind,
+            rtpParameters = rtpParameters,
+            appData = appData
+        )
+    }
+
     /**
      * Create a DataConsumer.
      */
@@ -63,6 +93,63 @@ class RecvTransport @CalledByNative private constructor(
         )
     }
 
+    /**
+     * Detect the dominant speaker among the open audio consumers of this transport, and those created later.
+     * Replaces the detector previously created on this transport.
+     *
+     * @param intervalMs how often audio levels are sampled.
+     * @param smoothing weight of the newest sample in the moving average, 0 exclusive to 1.
+     * @param thresholdDbov level below which a consumer is silent.
+     * @param marginDb how much louder than the current speaker another consumer must be to take over.
+     * @param switchDelayMs how long it must stay that much louder.
+     */
+    @JvmOverloads
+    fun createActiveSpeakerDetector(
+        listener: ActiveSpeakerDetector.Listener,
+        intervalMs: Int = 100,
+        smoothing: Double = 0.3,
+        thresholdDbov: Int = -50,
+        marginDb: Int = 6,
+        switchDelayMs: Int = 300,
+    ): ActiveSpeakerDetector {
+        checkTransportExists()
+        require(intervalMs > 0) { "intervalMs must be positive" }
+        require(smoothing > 0.0 && smoothing <= 1.0) { "smoothing must be in (0, 1]" }
+        val nativeDetector = nativeCreateActiveSpeakerDetector(
+            nativeTransport = nativeTransport,
+            listener = listener,
+            intervalMs = intervalMs,
+            smoothing = smoothing,
+            thresholdDbov = thresholdDbov,
+            marginDb = marginDb,
+            switchDelayMs = switchDelayMs,
+        )
+        return ActiveSpeakerDetector(nativeDetector)
+    }
+
+    /**
+     * Schedule video consumers of this transport by their visibility.
+     *
+     * @param debounceMs reports are applied once they have been quiet for this long.
+     * @param layerHeights height of each spatial layer, lowest first. A tile gets the smallest layer at least as tall.
+     */
+    @JvmOverloads
+    fun createVisibilityScheduler(
+        listener: VisibilityScheduler.Listener,
+        debounceMs: Int = 250,
+        layerHeights: IntArray = intArrayOf(180, 360, 720),
+    ): VisibilityScheduler {
+        checkTransportExists()
+        require(debounceMs >= 0) { "debounceMs must not be negative" }
+        val nativeScheduler = nativeCreateVisibilityScheduler(
+            nativeTransport = nativeTransport,
+            listener = listener,
+            debounceMs = debounceMs,
+            layerHeights = layerHeights,
+        )
+        return VisibilityScheduler(nativeScheduler)
+    }
+
     override fun checkTransportExists() {
         check(nativeTransport != 0L) { "RecvTransport has been disposed." }
     }
@@ -77,6 +164,17 @@ class RecvTransport @CalledByNative private constructor(
         appData: String?,
     ): Consumer
 
+    private external fun nativeSwapConsumer(
+        nativeTransport: Long,
+        nativeConsumer: Long,
+        listener: Consumer.Listener,
+        id: String,
+        producerId: String,
+        kind: String,
+        rtpParameters: String?,
+        appData: String?,
+    ): Consumer
+
     private external fun nativeConsumeData(
         nativeTransport: Long,
         listener: DataConsumer.Listener,
@@ -87,4 +185,21 @@ class RecvTransport @CalledByNative private constructor(
         protocol: String,
         appData: String?,
     ): DataConsumer
+
+    private external fun nativeCreateActiveSpeakerDetector(
+        nativeTransport: Long,
+        listener: ActiveSpeakerDetector.Listener,
+        intervalMs: Int,
+        smoothing: Double,
+        thresholdDbov: Int,
+        marginDb: Int,
+        switchDelayMs: Int,
+    ): Long
+
+    private external fun nativeCreateVisibilityScheduler(
+        nativeTransport: Long,
+        listener: VisibilityScheduler.Listener,
+        debounceMs: Int,
+        layerHeights: IntArray,
+    ): Long
 }
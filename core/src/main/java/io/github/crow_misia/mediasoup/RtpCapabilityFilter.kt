@@ -0,0 +1,18 @@
+package io.github.crow_misia.mediasoup
+
+/**
+ * Prunes the router RTP capabilities in [Device.load], before any transport is created,
+ * so SDP offers and answers only carry what the application uses.
+ *
+ * A null list keeps everything of its kind, an empty list removes everything.
+ *
+ * @property mimeTypes codec mime types, such as "audio/opus" or "video/VP8", case-insensitive.
+ * RTX is kept for the kept codecs.
+ * @property headerExtensions header extension URIs.
+ * @property rtcpFeedback RTCP feedback as "type" (all its parameters) or "type parameter", such as "nack" or "ccm fir".
+ */
+data class RtpCapabilityFilter(
+    val mimeTypes: Collection<String>? = null,
+    val headerExtensions: Collection<String>? = null,
+    val rtcpFeedback: Collection<String>? = null,
+)
@@ -0,0 +1,187 @@
+package io.github.crow_misia.mediasoup
+
+/**
+ * Spreads consumers over several RecvTransports, each with its own PeerConnection, so that their
+ * SDP negotiations and RTP demux do not all queue behind one transport.
+ *
+ * Every shard is a RecvTransport created with [Device.createRecvTransport] for its own WebRtcTransport
+ * on the server; a server transport cannot be split across PeerConnections, so the application signals
+ * each of them as usual. Consumers must be closed through [closeConsumer] or [swapConsumer] to keep
+ * the placement counts right.
+ *
+ * @param transports the shards, at least one.
+ * @param placement how a shard is picked for each new Consumer.
+ */
+class ShardedRecvTransport @JvmOverloads constructor(
+    transports: List<RecvTransport>,
+    private val placement: Placement = Placement.BY_COUNT,
+) {
+    /**
+     * Shard placement policy.
+     */
+    enum class Placement {
+        /**
+         * The shard with the fewest consumers.
+         */
+        BY_COUNT,
+
+        /**
+         * Audio on the first shard, video on the other shard with the fewest consumers.
+         * Audio keeps its own PeerConnection, away from video renegotiations.
+         */
+        BY_KIND,
+    }
+
+    /**
+     * The shards, in the order given.
+     */
+    val transports: List<RecvTransport> = transports.toList()
+
+    private val counts = IntArray(this.transports.size)
+    private val shards = HashMap<Consumer, Int>()
+
+    init {
+        require(this.transports.isNotEmpty()) { "transports must not be empty" }
+    }
+
+    /**
+     * Number of open consumers of each shard.
+     */
+    val consumerCounts: IntArray
+        get() = synchronized(this) { counts.copyOf() }
+
+    /**
+     * Create a Consumer on the shard picked by the placement policy.
+     */
+    @JvmOverloads
+    fun consume(
+        listener: Consumer.Listener,
+        id: String,
+        producerId: String,
+        kind: String,
+        rtpParameters: String? = null,
+        appData: String? = null,
+    ): Consumer {
+        val shard = reserve(kind)
+        var placed = false
+        try {
+            val consumer = transports[shard].consume(listener, id, producerId, kind, rtpParameters, appData)
+            synchronized(this) { shards[consumer] = shard }
+            placed = true
+            return consumer
+        } finally {
+            if (!placed) {
+                release(shard)
+            }
+        }
+    }
+
+    /**
+     * Close [consumer] and create a Consumer in its place, on the same shard.
+     * See [RecvTransport.swapConsumer]. [consumer] still has to be disposed.
+     */
+    @JvmOverloads
+    fun swapConsumer(
+        consumer: Consumer,
+        listener: Consumer.Listener,
+        id: String,
+        producerId: String,
+        kind: String,
+        rtpParameters: String? = null,
+        appData: String? = null,
+    ): Consumer {
+        // Fails on a disposed Consumer before its place is touched, as its state can no longer be read.
+        consumer.nativeHandle
+        val shard = synchronized(this) {
+            requireNotNull(shards.remove(consumer)) { "Consumer does not belong to this transport" }
+        }
+        var placed = false
+        try {
+            val swapped = transports[shard].swapConsumer(consumer, listener, id, producerId, kind, rtpParameters, appData)
+            synchronized(this) { shards[swapped] = shard }
+            placed = true
+            return swapped
+        } finally {
+            // A failed swap leaves the old Consumer closed, unless it failed before the close.
+            if (!placed) {
+                if (consumer.closed) {
+                    release(shard)
+                } else {
+                    synchronized(this) { shards[consumer] = shard }
+                }
+            }
+        }
+    }
+
+    /**
+     * Close [consumer] and free its place on its shard. [consumer] still has to be disposed.
+     */
+    fun closeConsumer(consumer: Consumer) {
+        val shard = synchronized(this) { shards.remove(consumer) } ?: return
+        try {
+            consumer.close()
+        } finally {
+            release(shard)
+        }
+    }
+
+    /**
+     * The shard [consumer] was created on, or null if it did not come from this transport.
+     */
+    fun transportOf(consumer: Consumer): RecvTransport? {
+        val shard = synchronized(this) { shards[consumer] } ?: return null
+        return transports[shard]
+    }
+
+    /**
+     * Create a DataConsumer on the first shard, the one whose server transport carries SCTP.
+     */
+    @JvmOverloads
+    fun consumeData(
+        listener: DataConsumer.Listener,
+        id: String,
+        producerId: String,
+        streamId: Int,
+        label: String,
+        protocol: String = "",
+        appData: String? = null,
+    ): DataConsumer {
+        return transports[0].consumeData(listener, id, producerId, streamId, label, protocol, appData)
+    }
+
+    /**
+     * Closes every shard.
+     */
+    fun close() {
+        transports.forEach { it.close() }
+        synchronized(this) {
+            shards.clear()
+            counts.fill(0)
+        }
+    }
+
+    /**
+     * Dispose every shard.
+     */
+    fun dispose() {
+        transports.forEach { it.dispose() }
+    }
+
+    @Synchronized
+    private fun reserve(kind: String): Int {
+        val candidates = when {
+            placement == Placement.BY_KIND && transports.size > 1 -> if (kind == "audio") 0..0 else 1 until transports.size
+            else -> transports.indices
+        }
+        val shard = candidates.minBy { counts[it] }
+        counts[shard]++
+        return shard
+    }
+
+    @Synchronized
+    private fun release(shard: Int) {
+        if (counts[shard] > 0) {
+            counts[shard]--
+        }
+    }
+}
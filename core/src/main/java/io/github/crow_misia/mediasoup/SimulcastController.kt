@@ -0,0 +1,39 @@
+package io.github.crow_misia.mediasoup
+
+/**
+ * Adapts the max spatial layer of a simulcast Producer, see [Producer.createSimulcastController].
+ *
+ * Every interval the Producer stats are sampled. The layers whose summed maxBitrate fits in the available
+ * outgoing bitrate are kept, and one more is dropped while the encoder is limited by CPU.
+ * Layers are lowered after a few samples in a row, and raised one at a time after more of them.
+ */
+class SimulcastController internal constructor(
+    private var nativeController: Long,
+) {
+    /**
+     * State as JSON: maxSpatialLayer, reason, raises, lowers, and the last decisions as
+     * `{ "timeMs", "from", "to", "reason", "availableOutgoingBitrate" }`.
+     * reason is one of "none", "bandwidth" or "cpu".
+     */
+    val metrics: String
+        get() {
+            checkControllerExists()
+            return nativeGetMetrics(nativeController)
+        }
+
+    fun dispose() {
+        val ptr = nativeController
+        if (ptr == 0L) {
+            return
+        }
+        nativeController = 0L
+        nativeDispose(ptr)
+    }
+
+    private fun checkControllerExists() {
+        check(nativeController != 0L) { "SimulcastController has been disposed." }
+    }
+
+    private external fun nativeGetMetrics(nativeController: Long): String
+    private external fun nativeDispose(nativeController: Long)
+}
@@ -0,0 +1,96 @@
+package io.github.crow_misia.mediasoup
+
+import org.webrtc.PeerConnectionFactory
+
+/**
+ * Scheduling of a PeerConnectionFactory thread.
+ *
+ * @property cpuAffinity Bit mask of the CPUs the thread may run on (bit n = cpu n), or 0 to keep the current affinity.
+ * @property niceValue Nice value (-20..19), or null to keep the current one.
+ * @property realtimePriority SCHED_FIFO priority (1..99), or 0 to keep the normal scheduler.
+ *   Regular apps are usually not allowed to use it.
+ */
+data class ThreadPolicy @JvmOverloads constructor(
+    val cpuAffinity: Long = 0L,
+    val niceValue: Int? = null,
+    val realtimePriority: Int = 0,
+) {
+    init {
+        require(niceValue == null || niceValue in -20..19) { "niceValue must be in -20..19" }
+        require(realtimePriority in 0..99) { "realtimePriority must be in 0..99" }
+    }
+
+    /**
+     * Threads owned by a PeerConnectionFactory.
+     */
+    enum class Target(val id: Int) {
+        NETWORK(0),
+        WORKER(1),
+        SIGNALING(2),
+    }
+
+    /**
+     * Apply the policy to a thread of the factory.
+     *
+     * @return true when every requested setting was applied; failures are logged.
+     */
+    fun applyTo(factory: PeerConnectionFactory, target: Target): Boolean {
+        return nativeApply(
+            ownedFactory = factory.nativeOwnedFactoryAndThreads,
+            target = target.id,
+            cpuAffinity = cpuAffinity,
+            niceValue = niceValue ?: Int.MIN_VALUE,
+            realtimePriority = realtimePriority,
+        )
+    }
+
+    companion object {
+        /**
+         * Time a task posted now waits before the thread runs it, in microseconds, or -1 on failure.
+         * Sampling it while Devices share the factory shows how busy its threads are.
+         */
+        @JvmStatic
+        fun measureQueueDelayMicros(factory: PeerConnectionFactory, target: Target): Long {
+            return nativeMeasureQueueDelay(factory.nativeOwnedFactoryAndThreads, target.id)
+        }
+
+        @JvmStatic
+        private external fun nativeMeasureQueueDelay(ownedFactory: Long, target: Int): Long
+
+        @JvmStatic
+        private external fun nativeApply(
+            ownedFactory: Long,
+            target: Int,
+            cpuAffinity: Long,
+            niceValue: Int,
+            realtimePriority: Int,
+        ): Boolean
+    }
+}
+
+/**
+ * Set the scheduling of the factory network, worker and signaling threads.
+ * Threads whose policy is null are left unchanged.
+ *
+ * @return true when every requested setting was applied.
+ */
+@JvmOverloads
+fun PeerConnectionFactory.setThreadPolicies(
+    network: ThreadPolicy? = null,
+    worker: ThreadPolicy? = null,
+    signaling: ThreadPolicy? = null,
+): Boolean {
+    var result = true
+    network?.also { result = it.applyTo(this, ThreadPolicy.Target.NETWORK) && result }
+    worker?.also { result = it.applyTo(this, ThreadPolicy.Target.WORKER) && result }
+    signaling?.also { result = it.applyTo(this, ThreadPolicy.Target.SIGNALING) && result }
+    return result
+}
+
+/**
+ * Queue delay of a factory thread in microseconds, see [ThreadPolicy.measureQueueDelayMicros].
+ */
+@JvmOverloads
+fun PeerConnectionFactory.measureQueueDelay(target: ThreadPolicy.Target = ThreadPolicy.Target.SIGNALING): Long {
+    return ThreadPolicy.measureQueueDelayMicros(this, target)
+}
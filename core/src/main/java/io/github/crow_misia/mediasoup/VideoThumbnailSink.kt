@@ -0,0 +1,81 @@
+package io.github.crow_misia.mediasoup
+
+import org.webrtc.VideoFrame
+
+/**
+ * Downscaled frames of a remote video track, see [Consumer.addThumbnailSink].
+ *
+ * Only the latest thumbnail is kept. Frames that were not polled in time, or that arrive while every pooled buffer
+ * is still held by unreleased frames, are dropped.
+ */
+class VideoThumbnailSink internal constructor(
+    private var nativeThumbnailSink: Long,
+) {
+    /**
+     * CPU time spent downscaling, in nanoseconds.
+     */
+    val cpuTimeNanos: Long
+        get() {
+            checkThumbnailSinkExists()
+            return nativeGetCpuTimeNanos(nativeThumbnailSink)
+        }
+
+    /**
+     * Frames returned by [poll].
+     */
+    val deliveredFrames: Long
+        get() {
+            checkThumbnailSinkExists()
+            return nativeGetDeliveredFrames(nativeThumbnailSink)
+        }
+
+    /**
+     * Frames dropped because the reader fell behind.
+     */
+    val droppedFrames: Long
+        get() {
+            checkThumbnailSinkExists()
+            return nativeGetDroppedFrames(nativeThumbnailSink)
+        }
+
+    /**
+     * Handle for mediasoup_video_thumbnail_sink_poll() of mediasoup_native.h.
+     * Valid until [dispose] is called.
+     */
+    val nativeHandle: Long
+        get() {
+            checkThumbnailSinkExists()
+            return nativeThumbnailSink
+        }
+
+    /**
+     * Take the latest thumbnail, or null if there is no new one.
+     * The frame must be released to give its buffer back to the pool.
+     */
+    fun poll(): VideoFrame? {
+        checkThumbnailSinkExists()
+        return nativePoll(nativeThumbnailSink)
+    }
+
+    /**
+     * Detach from the track.
+     */
+    fun dispose() {
+        val ptr = nativeThumbnailSink
+        if (ptr == 0L) {
+            return
+        }
+        nativeThumbnailSink = 0L
+        nativeDispose(ptr)
+    }
+
+    private fun checkThumbnailSinkExists() {
+        check(nativeThumbnailSink != 0L) { "VideoThumbnailSink has been disposed." }
+    }
+
+    private external fun nativePoll(nativeThumbnailSink: Long): VideoFrame?
+    private external fun nativeGetCpuTimeNanos(nativeThumbnailSink: Long): Long
+    private external fun nativeGetDeliveredFrames(nativeThumbnailSink: Long): Long
+    private external fun nativeGetDroppedFrames(nativeThumbnailSink: Long): Long
+    private external fun nativeDispose(nativeThumbnailSink: Long)
+}
@@ -0,0 +1,68 @@
+package io.github.crow_misia.mediasoup
+
+import org.webrtc.CalledByNative
+
+/**
+ * Pauses offscreen video consumers and caps the spatial layer of small ones,
+ * see [RecvTransport.createVisibilityScheduler].
+ *
+ * Tracks of offscreen consumers are disabled locally. Decoding only stops once the server stops forwarding,
+ * so the listener should relay the changes to the server (consumer pause / resume / setPreferredLayers).
+ */
+class VisibilityScheduler internal constructor(
+    private var nativeScheduler: Long,
+) {
+    interface Listener {
+        /**
+         * A batch of changes, as a JSON array of `{ "consumerId", "paused", "spatialLayer" }`.
+         * spatialLayer is absent for paused consumers. Called on the scheduler thread.
+         * Do not dispose the scheduler from here.
+         */
+        @CalledByNative("Listener")
+        fun onSchedule(changes: String)
+    }
+
+    /**
+     * Counters as JSON: consumers, pausedConsumers, batches, changes,
+     * and pausedMillis / cappedMillis, the total time consumers spent paused or below their top layer.
+     */
+    val metrics: String
+        get() {
+            checkSchedulerExists()
+            return nativeGetMetrics(nativeScheduler)
+        }
+
+    /**
+     * Report where a video consumer is rendered. A tile of zero size counts as not visible.
+     */
+    fun setVisibility(consumer: Consumer, visible: Boolean, width: Int, height: Int) {
+        checkSchedulerExists()
+        nativeSetVisibility(nativeScheduler, consumer.nativeHandle, visible, width, height)
+    }
+
+    /**
+     * Stop scheduling a consumer, before closing it.
+     */
+    fun remove(consumer: Consumer) {
+        checkSchedulerExists()
+        nativeRemove(nativeScheduler, consumer.nativeHandle)
+    }
+
+    fun dispose() {
+        val ptr = nativeScheduler
+        if (ptr == 0L) {
+            return
+        }
+        nativeScheduler = 0L
+        nativeDispose(ptr)
+    }
+
+    private fun checkSchedulerExists() {
+        check(nativeScheduler != 0L) { "VisibilityScheduler has been disposed." }
+    }
+
+    private external fun nativeSetVisibility(nativeScheduler: Long, nativeConsumer: Long, visible: Boolean, width: Int, height: Int)
+    private external fun nativeRemove(nativeScheduler: Long, nativeConsumer: Long)
+    private external fun nativeGetMetrics(nativeScheduler: Long): String
+    private external fun nativeDispose(nativeScheduler: Long)
+}
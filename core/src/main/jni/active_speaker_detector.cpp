@@ -0,0 +1,263 @@
+#define MSC_CLASS "active_speaker_detector"
+
+#include "active_speaker_detector.h"
+
+#include <api/media_stream_interface.h>
+#include <rtc_base/time_utils.h>
+#include <sdk/android/native_api/jni/java_types.h>
+
+#include <Logger.hpp>
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+#include "recv_transport.h"
+
+using namespace webrtc;
+
+namespace mediasoupclient
+{
+
+extern jmethodID activeSpeakerDetectorListenerOnActiveSpeakerChangeMethod;
+
+namespace
+{
+
+// Silence in RFC 6464, levels are reported as -dBov.
+constexpr double kSilenceDbov = 127;
+
+// Levels older than this belong to a consumer that stopped sending.
+constexpr int64_t kMaxLevelAgeMs = 1000;
+
+} // namespace
+
+extern "C"
+{
+
+  JNI_DEFINE_METHOD(jlong, RecvTransport, nativeCreateActiveSpeakerDetector, jlong j_transport, jobject j_listener, jint j_intervalMs, jdouble j_smoothing, jint j_thresholdDbov,
+                    jint j_marginDb, jint j_switchDelayMs)
+  {
+    MSC_TRACE();
+
+    return handleNativeCrash(env,
+                             [&]() {
+                               if (j_intervalMs <= 0 || j_smoothing <= 0 || j_smoothing > 1)
+                               {
+                                 throw std::invalid_argument("invalid active speaker detector settings");
+                               }
+                               ActiveSpeakerDetector::Settings settings{ j_intervalMs, j_smoothing, j_thresholdDbov, j_marginDb, j_switchDelayMs };
+                               auto* result = new OwnedActiveSpeakerDetector{ std::make_shared<ActiveSpeakerDetector>(env, JavaParamRef<jobject>(env, j_listener), settings) };
+                               static_cast<OwnedRecvTransport*>(getOwnedTransport(j_transport))->setSpeakerDetector(result->detector);
+                               return NativeToJavaPointer(result);
+                             })
+      .value_or(0L);
+  }
+
+  JNI_DEFINE_METHOD(void, ActiveSpeakerDetector, nativeDispose, jlong j_detector)
+  {
+    MSC_TRACE();
+
+    delete reinterpret_cast<OwnedActiveSpeakerDetector*>(j_detector);
+  }
+}
+
+void OwnedRecvTransport::setSpeakerDetector(std::weak_ptr<ActiveSpeakerDetector> detector)
+{
+  MSC_TRACE();
+
+  std::lock_guard<std::mutex> lock(speakerDetectorMutex_);
+  speakerDetector_ = std::move(detector);
+  if (auto current = speakerDetector_.lock())
+  {
+    pruneAudioReceivers();
+    for (const auto& [consumerId, receiver] : audioReceivers_)
+    {
+      current->addConsumer(consumerId, receiver);
+    }
+  }
+}
+
+void OwnedRecvTransport::addAudioConsumer(const std::string& consumerId, scoped_refptr<RtpReceiverInterface> receiver)
+{
+  MSC_TRACE();
+
+  std::lock_guard<std::mutex> lock(speakerDetectorMutex_);
+  pruneAudioReceivers();
+  if (auto detector = speakerDetector_.lock())
+  {
+    detector->addConsumer(consumerId, receiver);
+  }
+  audioReceivers_.emplace(consumerId, std::move(receiver));
+}
+
+void OwnedRecvTransport::pruneAudioReceivers()
+{
+  for (auto it = audioReceivers_.begin(); it != audioReceivers_.end();)
+  {
+    auto track = it->second->track();
+    if (!track || track->state() == MediaStreamTrackInterface::kEnded)
+    {
+      it = audioReceivers_.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+ActiveSpeakerDetector::ActiveSpeakerDetector(JNIEnv* env, const JavaRef<jobject>& j_listener, const Settings& settings) : j_listener_(env, j_listener), settings_(settings)
+{
+  MSC_TRACE();
+
+  thread_ = std::thread([this]() { run(); });
+}
+
+ActiveSpeakerDetector::~ActiveSpeakerDetector()
+{
+  MSC_TRACE();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  stopped_.notify_all();
+  thread_.join();
+}
+
+void ActiveSpeakerDetector::addConsumer(const std::string& consumerId, scoped_refptr<RtpReceiverInterface> receiver)
+{
+  MSC_TRACE();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  receivers_.emplace(consumerId, std::move(receiver));
+}
+
+void ActiveSpeakerDetector::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopped_.wait_for(lock, std::chrono::milliseconds(settings_.intervalMs), [this]() { return stop_; }))
+  {
+    // Receivers block on the worker thread, so they are read without holding the lock.
+    lock.unlock();
+    sample(rtc::TimeMillis());
+    lock.lock();
+  }
+}
+
+void ActiveSpeakerDetector::sample(int64_t nowMs)
+{
+  std::vector<std::pair<std::string, scoped_refptr<RtpReceiverInterface>>> receivers;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    receivers.assign(receivers_.begin(), receivers_.end());
+  }
+
+  std::vector<std::string> ended;
+  for (auto& [consumerId, receiver] : receivers)
+  {
+    auto track = receiver->track();
+    if (!track || track->state() == MediaStreamTrackInterface::kEnded)
+    {
+      ended.push_back(consumerId);
+      continue;
+    }
+
+    double level = 0;
+    for (const auto& source : receiver->GetSources())
+    {
+      if (source.source_type() == RtpSourceType::SSRC && source.audio_level() && nowMs - source.timestamp().ms() <= kMaxLevelAgeMs)
+      {
+        level = kSilenceDbov - *source.audio_level();
+        break;
+      }
+    }
+
+    auto& smoothed = levels_[consumerId];
+    smoothed += settings_.smoothing * (level - smoothed);
+  }
+
+  bool activeRemoved = false;
+  if (!ended.empty())
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& consumerId : ended)
+    {
+      receivers_.erase(consumerId);
+      levels_.erase(consumerId);
+      activeRemoved |= active_ == consumerId;
+    }
+  }
+
+  select(nowMs, activeRemoved);
+}
+
+void ActiveSpeakerDetector::select(int64_t nowMs, bool activeRemoved)
+{
+  const double threshold = kSilenceDbov + settings_.thresholdDbov;
+
+  std::optional<std::string> loudest;
+  double loudestLevel = threshold;
+  for (const auto& [consumerId, level] : levels_)
+  {
+    if (level >= loudestLevel)
+    {
+      loudest = consumerId;
+      loudestLevel = level;
+    }
+  }
+
+  // The last speaker stays active through silence, until someone else speaks or it goes away.
+  if (activeRemoved || !active_)
+  {
+    candidate_.reset();
+    if (activeRemoved || loudest)
+    {
+      active_ = loudest;
+      notify(active_);
+    }
+    return;
+  }
+
+  if (!loudest || *loudest == *active_ || loudestLevel < levels_[*active_] + settings_.marginDb)
+  {
+    candidate_.reset();
+    return;
+  }
+
+  if (candidate_ != loudest)
+  {
+    candidate_ = loudest;
+    candidateSinceMs_ = nowMs;
+  }
+  if (nowMs - candidateSinceMs_ >= settings_.switchDelayMs)
+  {
+    active_ = loudest;
+    candidate_.reset();
+    notify(active_);
+  }
+}
+
+void ActiveSpeakerDetector::notify(const std::optional<std::string>& consumerId)
+{
+  MSC_TRACE();
+
+  JNIEnv* env = AttachCurrentThreadIfNeeded();
+  ScopedJavaLocalRef<jstring> j_consumerId;
+  jint j_level = -static_cast<jint>(kSilenceDbov);
+  if (consumerId)
+  {
+    j_consumerId = NativeToJavaString(env, *consumerId);
+    j_level = static_cast<jint>(levels_[*consumerId] - kSilenceDbov);
+  }
+  env->CallVoidMethod(j_listener_.obj(), activeSpeakerDetectorListenerOnActiveSpeakerChangeMethod, j_consumerId.obj(), j_level);
+  // Left pending, an exception thrown by the listener would break every later JNI call of this thread.
+  if (env->ExceptionCheck())
+  {
+    MSC_WARN("active speaker listener threw an exception");
+    env->ExceptionDescribe();
+    env->ExceptionClear();
+  }
+}
+
+} // namespace mediasoupclient
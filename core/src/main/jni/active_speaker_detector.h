@@ -0,0 +1,88 @@
+#ifndef ACTIVE_SPEAKER_DETECTOR_H_
+#define ACTIVE_SPEAKER_DETECTOR_H_
+
+#include <jni.h>
+#include <sdk/android/native_api/jni/scoped_java_ref.h>
+
+#include <api/rtp_receiver_interface.h>
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "jni_common.h"
+#include "jni_util.h"
+
+namespace mediasoupclient
+{
+
+extern "C"
+{
+
+  JNI_DEFINE_METHOD(void, ActiveSpeakerDetector, nativeDispose, jlong j_detector);
+}
+
+// Picks the dominant speaker among the audio consumers of a RecvTransport.
+// Audio levels are read from the RTP receivers (RFC 6464 header extension) on a sampling thread,
+// smoothed, and only changes of the dominant speaker are reported to the Java listener.
+class ActiveSpeakerDetector final
+{
+public:
+  struct Settings
+  {
+    int intervalMs;
+    // Weight of the newest sample in the moving average, 0..1.
+    double smoothing;
+    // Level below which a consumer is considered silent.
+    int thresholdDbov;
+    // How much louder than the current speaker a candidate must be...
+    int marginDb;
+    // ...and for how long, to take over.
+    int switchDelayMs;
+  };
+
+  ActiveSpeakerDetector(JNIEnv* env, const JavaRef<jobject>& j_listener, const Settings& settings);
+  ~ActiveSpeakerDetector();
+
+  ActiveSpeakerDetector(const ActiveSpeakerDetector&) = delete;
+  ActiveSpeakerDetector& operator=(const ActiveSpeakerDetector&) = delete;
+
+  void addConsumer(const std::string& consumerId, webrtc::scoped_refptr<webrtc::RtpReceiverInterface> receiver);
+
+private:
+  void run();
+  void sample(int64_t nowMs);
+  void select(int64_t nowMs, bool activeRemoved);
+  void notify(const std::optional<std::string>& consumerId);
+
+  const ScopedJavaGlobalRef<jobject> j_listener_;
+  const Settings settings_;
+
+  std::mutex mutex_;
+  std::condition_variable stopped_;
+  bool stop_{ false };
+  std::map<std::string, webrtc::scoped_refptr<webrtc::RtpReceiverInterface>> receivers_;
+
+  // Sampling thread only.
+  // Smoothed level of each consumer in dB above silence (0 = -127 dBov).
+  std::map<std::string, double> levels_;
+  std::optional<std::string> active_;
+  std::optional<std::string> candidate_;
+  int64_t candidateSinceMs_{ 0 };
+
+  std::thread thread_;
+};
+
+// Handle held by Java. The RecvTransport only keeps a weak reference to add new consumers.
+struct OwnedActiveSpeakerDetector
+{
+  std::shared_ptr<ActiveSpeakerDetector> detector;
+};
+
+} // namespace mediasoupclient
+
+#endif // ACTIVE_SPEAKER_DETECTOR_H_
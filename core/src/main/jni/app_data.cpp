@@ -0,0 +1,29 @@
+#define MSC_CLASS "app_data"
+
+#include "app_data.h"
+
+#include <sdk/android/native_api/jni/java_types.h>
+
+using namespace webrtc;
+
+namespace mediasoupclient
+{
+
+AppData::AppData(JNIEnv* env, jstring j_appData, bool opaque) : opaque_(opaque)
+{
+  if (opaque_ && j_appData != nullptr)
+  {
+    j_appData_ = ScopedJavaGlobalRef<jstring>(env, JavaParamRef<jstring>(env, j_appData));
+  }
+}
+
+ScopedJavaLocalRef<jstring> AppData::toJava(JNIEnv* env) const
+{
+  if (j_appData_.is_null())
+  {
+    return NativeToJavaString(env, "{}");
+  }
+  return ScopedJavaLocalRef<jstring>(env, static_cast<jstring>(env->NewLocalRef(j_appData_.obj())));
+}
+
+} // namespace mediasoupclient
@@ -0,0 +1,39 @@
+#ifndef APP_DATA_H_
+#define APP_DATA_H_
+
+#include <jni.h>
+#include <sdk/android/native_api/jni/scoped_java_ref.h>
+
+#include "jni_common.h"
+
+namespace mediasoupclient
+{
+
+// appData of a transport, producer or consumer in opaque mode (see Device).
+// The Java string is kept as given and handed back as is; libmediasoupclient only gets an empty object.
+class AppData final
+{
+public:
+  AppData() = default;
+  // Keeps |j_appData| when |opaque|, otherwise appData goes through libmediasoupclient as json.
+  AppData(JNIEnv* env, jstring j_appData, bool opaque);
+
+  AppData(AppData&&) = default;
+  AppData& operator=(AppData&&) = default;
+
+  bool opaque() const { return opaque_; }
+
+  // The kept string. Null when not opaque or when no appData was given.
+  jstring obj() const { return j_appData_.obj(); }
+
+  // The kept string, "{}" when no appData was given.
+  webrtc::ScopedJavaLocalRef<jstring> toJava(JNIEnv* env) const;
+
+private:
+  bool opaque_{ false };
+  webrtc::ScopedJavaGlobalRef<jstring> j_appData_;
+};
+
+} // namespace mediasoupclient
+
+#endif // APP_DATA_H_
@@ -0,0 +1,202 @@
+#define MSC_CLASS "audio_sink"
+
+#include "audio_sink.h"
+
+#include <Logger.hpp>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "consumer.h"
+
+using namespace webrtc;
+
+namespace mediasoupclient
+{
+
+extern "C"
+{
+
+  JNI_DEFINE_METHOD(jlong, Consumer, nativeAddAudioSink, jlong j_consumer, jint j_sampleRate, jint j_channels, jint j_capacityFrames)
+  {
+    MSC_TRACE();
+
+    return handleNativeCrash(env,
+                             [&]() {
+                               if (j_sampleRate < 8000 || j_sampleRate > 48000 || j_sampleRate % 100 != 0 || j_channels < 1 || j_channels > 2 || j_capacityFrames <= 0)
+                               {
+                                 throw std::invalid_argument("invalid audio sink format");
+                               }
+                               auto* track = reinterpret_cast<OwnedConsumer*>(j_consumer)->consumer()->GetTrack();
+                               if (track->kind() != MediaStreamTrackInterface::kAudioKind)
+                               {
+                                 throw std::invalid_argument("not an audio consumer");
+                               }
+                               auto* result = new AudioSink(scoped_refptr<AudioTrackInterface>(static_cast<AudioTrackInterface*>(track)), j_sampleRate, j_channels, j_capacityFrames);
+                               return NativeToJavaPointer(result);
+                             })
+      .value_or(0L);
+  }
+
+  JNI_DEFINE_METHOD(jint, AudioSink, nativeRead, jlong j_audioSink, jobject j_buffer, jint j_offset, jint j_length)
+  {
+    MSC_TRACE();
+
+    return handleNativeCrash(env,
+                             [&]() {
+                               auto* address = static_cast<uint8_t*>(env->GetDirectBufferAddress(j_buffer));
+                               if (address == nullptr)
+                               {
+                                 throw std::invalid_argument("buffer is not direct");
+                               }
+                               auto capacity = env->GetDirectBufferCapacity(j_buffer);
+                               if (j_offset < 0 || j_length < 0 || j_offset > capacity - j_length)
+                               {
+                                 throw std::out_of_range("offset and length exceed the buffer");
+                               }
+                               auto& ring = reinterpret_cast<AudioSink*>(j_audioSink)->ring();
+                               auto maxFrames = static_cast<size_t>(j_length) / (ring.frameSamples() * sizeof(int16_t));
+                               auto result = ring.pop(reinterpret_cast<int16_t*>(address + j_offset), maxFrames);
+                               return static_cast<jint>(result);
+                             })
+      .value_or(0);
+  }
+
+  JNI_DEFINE_METHOD(jint, AudioSink, nativeGetAvailableFrames, jlong j_audioSink)
+  {
+    MSC_TRACE();
+
+    return static_cast<jint>(reinterpret_cast<AudioSink*>(j_audioSink)->ring().available());
+  }
+
+  JNI_DEFINE_METHOD(jlong, AudioSink, nativeGetDroppedFrames, jlong j_audioSink)
+  {
+    MSC_TRACE();
+
+    return static_cast<jlong>(reinterpret_cast<AudioSink*>(j_audioSink)->droppedFrames());
+  }
+
+  JNI_DEFINE_METHOD(void, AudioSink, nativeDispose, jlong j_audioSink)
+  {
+    MSC_TRACE();
+
+    delete reinterpret_cast<AudioSink*>(j_audioSink);
+  }
+}
+
+AudioFrameRing::AudioFrameRing(size_t frameSamples, size_t capacityFrames)
+  : frameSamples_(frameSamples), capacityFrames_(capacityFrames), storage_(frameSamples * capacityFrames)
+{
+}
+
+size_t AudioFrameRing::available() const
+{
+  return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+}
+
+bool AudioFrameRing::push(const int16_t* frame)
+{
+  auto head = head_.load(std::memory_order_relaxed);
+  if (head - tail_.load(std::memory_order_acquire) == capacityFrames_)
+  {
+    return false;
+  }
+  std::memcpy(&storage_[(head % capacityFrames_) * frameSamples_], frame, frameSamples_ * sizeof(int16_t));
+  head_.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+size_t AudioFrameRing::pop(int16_t* dst, size_t maxFrames)
+{
+  auto tail = tail_.load(std::memory_order_relaxed);
+  auto count = std::min(head_.load(std::memory_order_acquire) - tail, maxFrames);
+  for (size_t i = 0; i < count; ++i)
+  {
+    std::memcpy(dst + i * frameSamples_, &storage_[((tail + i) % capacityFrames_) * frameSamples_], frameSamples_ * sizeof(int16_t));
+  }
+  tail_.store(tail + count, std::memory_order_release);
+  return count;
+}
+
+AudioSink::AudioSink(scoped_refptr<AudioTrackInterface> track, int sampleRate, size_t channels, size_t capacityFrames)
+  : track_(std::move(track)), sampleRate_(sampleRate), channels_(channels), ring_(static_cast<size_t>(sampleRate / 100) * channels, capacityFrames), output_(ring_.frameSamples())
+{
+  MSC_TRACE();
+
+  track_->AddSink(this);
+}
+
+AudioSink::~AudioSink()
+{
+  MSC_TRACE();
+
+  // OnData() is not called anymore once RemoveSink() returns.
+  track_->RemoveSink(this);
+}
+
+void AudioSink::OnData(const void* audioData, int bitsPerSample, int sampleRate, size_t numberOfChannels, size_t numberOfFrames)
+{
+  // PushResampler works on 10 ms frames, which rates that are not a multiple of 100 Hz do not divide into.
+  if (bitsPerSample != 16 || sampleRate <= 0 || sampleRate % 100 != 0 || numberOfChannels == 0 || numberOfFrames == 0)
+  {
+    return;
+  }
+
+  if (sampleRate != inputRate_)
+  {
+    if (resampler_.InitializeIfNeeded(sampleRate, sampleRate_, channels_) != 0)
+    {
+      MSC_WARN("cannot resample from %d Hz", sampleRate);
+      inputRate_ = 0;
+      return;
+    }
+    inputRate_ = sampleRate;
+    input_.assign(static_cast<size_t>(sampleRate / 100) * channels_, 0);
+    inputSize_ = 0;
+  }
+
+  const auto* input = static_cast<const int16_t*>(audioData);
+  for (size_t frame = 0; frame < numberOfFrames; ++frame)
+  {
+    for (size_t channel = 0; channel < channels_; ++channel)
+    {
+      input_[inputSize_++] = mix(input, numberOfChannels, frame, channel);
+    }
+    if (inputSize_ == input_.size())
+    {
+      inputSize_ = 0;
+      flush();
+    }
+  }
+}
+
+int16_t AudioSink::mix(const int16_t* input, size_t inputChannels, size_t frame, size_t channel) const
+{
+  const auto* samples = input + frame * inputChannels;
+  if (channels_ == 1 && inputChannels > 1)
+  {
+    int32_t sum = 0;
+    for (size_t i = 0; i < inputChannels; ++i)
+    {
+      sum += samples[i];
+    }
+    return static_cast<int16_t>(sum / static_cast<int32_t>(inputChannels));
+  }
+  return samples[channel % inputChannels];
+}
+
+void AudioSink::flush()
+{
+  const int16_t* frame = input_.data();
+  if (inputRate_ != sampleRate_)
+  {
+    resampler_.Resample(InterleavedView<const int16_t>(input_.data(), input_.size() / channels_, channels_), InterleavedView<int16_t>(output_.data(), output_.size() / channels_, channels_));
+    frame = output_.data();
+  }
+  if (!ring_.push(frame))
+  {
+    droppedFrames_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+} // namespace mediasoupclient
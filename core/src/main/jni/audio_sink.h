@@ -0,0 +1,94 @@
+#ifndef AUDIO_SINK_H_
+#define AUDIO_SINK_H_
+
+#include <jni.h>
+
+#include <api/media_stream_interface.h>
+#include <common_audio/resampler/include/push_resampler.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "jni_common.h"
+#include "jni_util.h"
+
+namespace mediasoupclient
+{
+
+extern "C"
+{
+
+  JNI_DEFINE_METHOD(jlong, Consumer, nativeAddAudioSink, jlong j_consumer, jint j_sampleRate, jint j_channels, jint j_capacityFrames);
+
+  JNI_DEFINE_METHOD(jint, AudioSink, nativeRead, jlong j_audioSink, jobject j_buffer, jint j_offset, jint j_length);
+
+  JNI_DEFINE_METHOD(jint, AudioSink, nativeGetAvailableFrames, jlong j_audioSink);
+
+  JNI_DEFINE_METHOD(jlong, AudioSink, nativeGetDroppedFrames, jlong j_audioSink);
+
+  JNI_DEFINE_METHOD(void, AudioSink, nativeDispose, jlong j_audioSink);
+}
+
+// Single producer / single consumer ring of fixed size PCM frames.
+// push() is called on the audio thread and pop() on the reader thread, neither of them blocks.
+class AudioFrameRing final
+{
+public:
+  AudioFrameRing(size_t frameSamples, size_t capacityFrames);
+
+  size_t frameSamples() const { return frameSamples_; }
+  size_t available() const;
+
+  // Returns false and drops |frame| when the ring is full.
+  bool push(const int16_t* frame);
+  // Copies up to |maxFrames| frames into |dst| and returns how many were copied.
+  size_t pop(int16_t* dst, size_t maxFrames);
+
+private:
+  const size_t frameSamples_;
+  const size_t capacityFrames_;
+  std::vector<int16_t> storage_;
+  std::atomic<size_t> head_{ 0 };
+  std::atomic<size_t> tail_{ 0 };
+};
+
+// Taps the decoded audio of a remote track.
+// Frames are mixed to |channels|, gathered into 10 ms frames and resampled to |sampleRate| for the ring.
+class AudioSink final : public webrtc::AudioTrackSinkInterface
+{
+public:
+  AudioSink(webrtc::scoped_refptr<webrtc::AudioTrackInterface> track, int sampleRate, size_t channels, size_t capacityFrames);
+  ~AudioSink() override;
+
+  AudioSink(const AudioSink&) = delete;
+  AudioSink& operator=(const AudioSink&) = delete;
+
+  void OnData(const void* audioData, int bitsPerSample, int sampleRate, size_t numberOfChannels, size_t numberOfFrames) override;
+
+  AudioFrameRing& ring() { return ring_; }
+  uint64_t droppedFrames() const { return droppedFrames_.load(std::memory_order_relaxed); }
+
+private:
+  // Channel |channel| of the output for input frame |frame|.
+  int16_t mix(const int16_t* input, size_t inputChannels, size_t frame, size_t channel) const;
+  // Pushes the 10 ms gathered in |input_|, resampled when needed.
+  void flush();
+
+  const webrtc::scoped_refptr<webrtc::AudioTrackInterface> track_;
+  const int sampleRate_;
+  const size_t channels_;
+  AudioFrameRing ring_;
+  std::atomic<uint64_t> droppedFrames_{ 0 };
+
+  // Audio thread only.
+  webrtc::PushResampler<int16_t> resampler_;
+  int inputRate_{ 0 };
+  std::vector<int16_t> input_;
+  size_t inputSize_{ 0 };
+  std::vector<int16_t> output_;
+};
+
+} // namespace mediasoupclient
+
+#endif // AUDIO_SINK_H_
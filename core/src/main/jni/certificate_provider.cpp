@@ -0,0 +1,224 @@
+#define MSC_CLASS "certificate_provider"
+
+#include "certificate_provider.h"
+
+#include <rtc_base/rtc_certificate_generator.h>
+#include <rtc_base/time_utils.h>
+#include <sdk/android/native_api/jni/java_types.h>
+
+#include <Logger.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "json_parser.h"
+
+using namespace webrtc;
+
+namespace mediasoupclient
+{
+
+namespace
+{
+
+// RTCCertificateGenerator caps the validity at one year, and whole seconds are stored in the certificate.
+constexpr int64_t kMinLifetimeMs = 1000;
+constexpr int64_t kMaxLifetimeMs = int64_t{ 365 } * 24 * 60 * 60 * rtc::kNumMillisecsPerSec;
+
+} // namespace
+
+extern "C"
+{
+
+  JNI_DEFINE_METHOD(jlong, DtlsCertificateProvider, nativeNew, jlong j_lifetimeMs)
+  {
+    MSC_TRACE();
+
+    return handleNativeCrash(env,
+                             [&]() {
+                               if (j_lifetimeMs < kMinLifetimeMs)
+                               {
+                                 throw std::invalid_argument("lifetimeMs must be at least one second");
+                               }
+                               auto lifetimeMs = std::min<int64_t>(j_lifetimeMs, kMaxLifetimeMs);
+                               auto* result = new OwnedCertificateProvider{ std::make_shared<CertificateProvider>(lifetimeMs) };
+                               return NativeToJavaPointer(result);
+                             })
+      .value_or(0L);
+  }
+
+  JNI_DEFINE_METHOD(jobjectArray, DtlsCertificateProvider, nativeExportPem, jlong j_provider)
+  {
+    MSC_TRACE();
+
+    return handleNativeCrash(env,
+                             [&]() -> jobjectArray {
+                               auto certificate = reinterpret_cast<OwnedCertificateProvider*>(j_provider)->provider->certificate();
+                               if (!certificate)
+                               {
+                                 return nullptr;
+                               }
+                               auto pem = certificate->ToPEM();
+                               return NativeToJavaStringArray(env, { pem.private_key(), pem.certificate() }).Release();
+                             })
+      .value_or(nullptr);
+  }
+
+  JNI_DEFINE_METHOD(void, DtlsCertificateProvider, nativeImportPem, jlong j_provider, jstring j_privateKey, jstring j_certificate)
+  {
+    MSC_TRACE();
+
+    handleNativeCrashNoReturn(env, [&]() {
+      auto privateKey = JavaToNativeString(env, JavaParamRef<jstring>(env, j_privateKey));
+      auto certificate = JavaToNativeString(env, JavaParamRef<jstring>(env, j_certificate));
+      reinterpret_cast<OwnedCertificateProvider*>(j_provider)->provider->importPem(privateKey, certificate);
+    });
+  }
+
+  JNI_DEFINE_METHOD(jstring, DtlsCertificateProvider, nativeGetMetrics, jlong j_provider)
+  {
+    MSC_TRACE();
+
+    return handleNativeCrash(env,
+                             [&]() {
+                               auto result = reinterpret_cast<OwnedCertificateProvider*>(j_provider)->provider->metrics();
+                               return NativeToJavaJson(env, result).Release();
+                             })
+      .value_or(nullptr);
+  }
+
+  JNI_DEFINE_METHOD(void, DtlsCertificateProvider, nativeDispose, jlong j_provider)
+  {
+    MSC_TRACE();
+
+    delete reinterpret_cast<OwnedCertificateProvider*>(j_provider);
+  }
+}
+
+CertificateProvider::CertificateProvider(int64_t lifetimeMs) : lifetimeMs_(lifetimeMs)
+{
+  MSC_TRACE();
+
+  thread_ = std::thread([this]() { run(); });
+}
+
+CertificateProvider::~CertificateProvider()
+{
+  MSC_TRACE();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  changed_.notify_all();
+  thread_.join();
+}
+
+rtc::scoped_refptr<rtc::RTCCertificate> CertificateProvider::certificate()
+{
+  MSC_TRACE();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto now = rtc::TimeUTCMillis();
+  if (usable(now))
+  {
+    ++reused_;
+    if (!fresh(now) && !requested_)
+    {
+      requested_ = true;
+      changed_.notify_all();
+    }
+    return certificate_;
+  }
+
+  ++waits_;
+  requested_ = true;
+  changed_.notify_all();
+  changed_.wait(lock, [this]() { return stop_ || !requested_; });
+  return usable(rtc::TimeUTCMillis()) ? certificate_ : nullptr;
+}
+
+void CertificateProvider::importPem(const std::string& privateKey, const std::string& certificate)
+{
+  MSC_TRACE();
+
+  auto imported = rtc::RTCCertificate::FromPEM(rtc::RTCCertificatePEM(privateKey, certificate));
+  if (!imported)
+  {
+    throw std::invalid_argument("invalid certificate PEM");
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto now = rtc::TimeUTCMillis();
+  // Certificates saved by a previous run are only taken while they are as good as the current one.
+  if (imported->HasExpired(now) || (certificate_ && imported->Expires() <= certificate_->Expires()))
+  {
+    return;
+  }
+  certificate_ = imported;
+  requested_ = !fresh(now);
+  changed_.notify_all();
+}
+
+json CertificateProvider::metrics()
+{
+  MSC_TRACE();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  json result = {
+    { "generated", generated_ },
+    { "reused", reused_ },
+    { "waits", waits_ },
+    { "lastGenerationMillis", generationMs_ },
+  };
+  if (certificate_)
+  {
+    result["expiresMillis"] = certificate_->Expires();
+  }
+  return result;
+}
+
+void CertificateProvider::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true)
+  {
+    changed_.wait(lock, [this]() { return stop_ || requested_; });
+    if (stop_)
+    {
+      break;
+    }
+
+    lock.unlock();
+    auto start = rtc::TimeMillis();
+    auto certificate = rtc::RTCCertificateGenerator::GenerateCertificate(rtc::KeyParams::ECDSA(), static_cast<uint64_t>(lifetimeMs_));
+    auto elapsed = rtc::TimeMillis() - start;
+    lock.lock();
+
+    if (certificate)
+    {
+      certificate_ = certificate;
+      ++generated_;
+      generationMs_ = elapsed;
+      MSC_DEBUG("DTLS certificate generated in %lld ms", static_cast<long long>(elapsed));
+    }
+    else
+    {
+      MSC_WARN("DTLS certificate generation failed");
+    }
+    requested_ = false;
+    changed_.notify_all();
+  }
+}
+
+bool CertificateProvider::usable(int64_t nowMs) const
+{
+  return certificate_ && static_cast<int64_t>(certificate_->Expires()) - nowMs > lifetimeMs_ / 4;
+}
+
+bool CertificateProvider::fresh(int64_t nowMs) const
+{
+  return certificate_ && static_cast<int64_t>(certificate_->Expires()) - nowMs > lifetimeMs_ / 2;
+}
+
+} // namespace mediasoupclient
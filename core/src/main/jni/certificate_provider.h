@@ -0,0 +1,82 @@
+#ifndef CERTIFICATE_PROVIDER_H_
+#define CERTIFICATE_PROVIDER_H_
+
+#include <jni.h>
+
+#include <rtc_base/rtc_certificate.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "jni_common.h"
+#include "jni_util.h"
+
+namespace mediasoupclient
+{
+
+extern "C"
+{
+
+  JNI_DEFINE_METHOD(jlong, DtlsCertificateProvider, nativeNew, jlong j_lifetimeMs);
+
+  JNI_DEFINE_METHOD(jobjectArray, DtlsCertificateProvider, nativeExportPem, jlong j_provider);
+
+  JNI_DEFINE_METHOD(void, DtlsCertificateProvider, nativeImportPem, jlong j_provider, jstring j_privateKey, jstring j_certificate);
+
+  JNI_DEFINE_METHOD(jstring, DtlsCertificateProvider, nativeGetMetrics, jlong j_provider);
+
+  JNI_DEFINE_METHOD(void, DtlsCertificateProvider, nativeDispose, jlong j_provider);
+}
+
+// ECDSA DTLS certificates for the PeerConnections of transports, generated ahead of time on a background thread
+// and reused while they have more than a quarter of their lifetime left. Past half of it, the next one is
+// generated in the background.
+class CertificateProvider final
+{
+public:
+  explicit CertificateProvider(int64_t lifetimeMs);
+  ~CertificateProvider();
+
+  CertificateProvider(const CertificateProvider&) = delete;
+  CertificateProvider& operator=(const CertificateProvider&) = delete;
+
+  // Waits for the generation when there is no usable certificate. Null when it failed.
+  rtc::scoped_refptr<rtc::RTCCertificate> certificate();
+
+  void importPem(const std::string& privateKey, const std::string& certificate);
+
+  json metrics();
+
+private:
+  void run();
+  bool usable(int64_t nowMs) const;
+  bool fresh(int64_t nowMs) const;
+
+  const int64_t lifetimeMs_;
+
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  bool stop_{ false };
+  bool requested_{ true };
+  rtc::scoped_refptr<rtc::RTCCertificate> certificate_;
+
+  uint64_t generated_{ 0 };
+  uint64_t reused_{ 0 };
+  uint64_t waits_{ 0 };
+  int64_t generationMs_{ 0 };
+
+  std::thread thread_;
+};
+
+struct OwnedCertificateProvider
+{
+  std::shared_ptr<CertificateProvider> provider;
+};
+
+} // namespace mediasoupclient
+
+#endif // CERTIFICATE_PROVIDER_H_
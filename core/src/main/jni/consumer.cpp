@@ -8,6 +8,9 @@
 #include <Consumer.hpp>
 #include <Logger.hpp>
 
+#include "json_parser.h"
+#include "transport_lock.h"
+
 using namespace webrtc;
 
 namespace mediasoupclient
@@ -17,6 +20,16 @@ extern jclass consumerClass;
 extern jmethodID consumerConstructorMethod;
 extern jmethodID consumerListenerOnTransportCloseMethod;
 
+namespace
+{
+
+std::recursive_mutex &transportMutexOf(jlong j_consumer)
+{
+  return *reinterpret_cast<OwnedConsumer *>(j_consumer)->transportMutex();
+}
+
+} // namespace
+
 extern "C"
 {
 
@@ -111,7 +124,7 @@ extern "C"
     return handleNativeCrash(env,
                              [&]() {
                                auto result = getConsumer(j_consumer)->GetRtpParameters();
-                               return NativeToJavaString(env, result.dump()).Release();
+                               return NativeToJavaJson(env, result).Release();
                              })
       .value_or(nullptr);
   }
@@ -134,8 +147,12 @@ extern "C"
 
     return handleNativeCrash(env,
                              [&]() {
+                               if (const auto &appData = reinterpret_cast<OwnedConsumer *>(j_consumer)->appData(); appData.opaque())
+                               {
+                                 return appData.toJava(env).Release();
+                               }
                                auto result = getConsumer(j_consumer)->GetAppData();
-                               return NativeToJavaString(env, result.dump()).Release();
+                               return NativeToJavaJson(env, result).Release();
                              })
       .value_or(nullptr);
   }
@@ -144,7 +161,10 @@ extern "C"
   {
     MSC_TRACE();
 
-    handleNativeCrashNoReturn(env, [&]() { getConsumer(j_consumer)->Close(); });
+    handleNativeCrashNoReturn(env, [&]() {
+      TransportLock lock(transportMutexOf(j_consumer));
+      getConsumer(j_consumer)->Close();
+    });
   }
 
   JNI_DEFINE_METHOD(jstring, Consumer, nativeGetStats, jlong j_consumer)
@@ -153,8 +173,9 @@ extern "C"
 
     return handleNativeCrash(env,
                              [&]() {
+                               TransportLock lock(transportMutexOf(j_consumer));
                                auto result = getConsumer(j_consumer)->GetStats();
-                               return NativeToJavaString(env, result.dump()).Release();
+                               return NativeToJavaJson(env, result).Release();
                              })
       .value_or(nullptr);
   }
@@ -163,14 +184,20 @@ extern "C"
   {
     MSC_TRACE();
 
-    handleNativeCrashNoReturn(env, [&]() { getConsumer(j_consumer)->Pause(); });
+    handleNativeCrashNoReturn(env, [&]() {
+      TransportLock lock(transportMutexOf(j_consumer));
+      getConsumer(j_consumer)->Pause();
+    });
   }
 
   JNI_DEFINE_METHOD(void, Consumer, nativeResume, jlong j_consumer)
   {
     MSC_TRACE();
 
-    handleNativeCrashNoReturn(env, [&]() { getConsumer(j_consumer)->Resume(); });
+    handleNativeCrashNoReturn(env, [&]() {
+      TransportLock lock(transportMutexOf(j_consumer));
+      getConsumer(j_consumer)->Resume();
+    });
   }
 
   JNI_DEFINE_METHOD(void, Consumer, nativeDispose, jlong j_consumer)
@@ -194,11 +221,12 @@ inline Consumer *getConsumer(jlong j_consumer)
   return reinterpret_cast<OwnedConsumer *>(j_consumer)->consumer();
 }
 
-ScopedJavaLocalRef<jobject> NativeToJavaConsumer(JNIEnv *env, Consumer *consumer, ConsumerListenerJni *listener)
+ScopedJavaLocalRef<jobject> NativeToJavaConsumer(JNIEnv *env, Consumer *consumer, ConsumerListenerJni *listener, UsageToken usage, AppData appData,
+                                                 std::shared_ptr<std::recursive_mutex> transportMutex)
 {
   MSC_TRACE();
 
-  auto ownedConsumer = new OwnedConsumer(consumer, listener);
+  auto ownedConsumer = new OwnedConsumer(consumer, listener, std::move(usage), std::move(appData), std::move(transportMutex));
   auto j_consumer = ScopedJavaLocalRef<jobject>(env, env->NewObject(consumerClass, consumerConstructorMethod, NativeToJavaPointer(ownedConsumer)));
   listener->SetJConsumer(env, j_consumer);
   return j_consumer;
@@ -4,9 +4,14 @@
 #include <jni.h>
 
 #include <Consumer.hpp>
+#include <memory>
+#include <mutex>
 
+#include "app_data.h"
+#include "device_usage.h"
 #include "jni_common.h"
 #include "jni_util.h"
+#include "rtp_parameters.h"
 
 namespace mediasoupclient
 {
@@ -65,7 +70,10 @@ private:
 class OwnedConsumer
 {
 public:
-  OwnedConsumer(Consumer *consumer, ConsumerListenerJni *listener) : consumer_(consumer), listener_(listener) {}
+  OwnedConsumer(Consumer *consumer, ConsumerListenerJni *listener, UsageToken usage, AppData appData, std::shared_ptr<std::recursive_mutex> transportMutex)
+    : consumer_(consumer), listener_(listener), usage_(std::move(usage)), appData_(std::move(appData)), transportMutex_(std::move(transportMutex))
+  {
+  }
 
   ~OwnedConsumer()
   {
@@ -74,15 +82,30 @@ public:
   }
 
   Consumer *consumer() const { return consumer_; }
+  // Typed copy of the RTP parameters, built on first use as only the layer readers need it.
+  const rtp::Parameters &rtpParameters() const
+  {
+    std::call_once(rtpParametersOnce_, [this]() { rtpParameters_ = rtp::Parameters::fromJson(consumer_->GetRtpParameters()); });
+    return rtpParameters_;
+  }
+  const AppData &appData() const { return appData_; }
+  // Held around the operations of the consumer, as around those of its transport. Also tells which transport it belongs to.
+  const std::shared_ptr<std::recursive_mutex> &transportMutex() const { return transportMutex_; }
 
 private:
   Consumer *consumer_;
   ConsumerListenerJni *listener_;
+  UsageToken usage_;
+  AppData appData_;
+  mutable std::once_flag rtpParametersOnce_;
+  mutable rtp::Parameters rtpParameters_;
+  const std::shared_ptr<std::recursive_mutex> transportMutex_;
 };
 
 inline Consumer *getConsumer(jlong j_consumer);
 
-ScopedJavaLocalRef<jobject> NativeToJavaConsumer(JNIEnv *env, Consumer *consumer, ConsumerListenerJni *listener);
+ScopedJavaLocalRef<jobject> NativeToJavaConsumer(JNIEnv *env, Consumer *consumer, ConsumerListenerJni *listener, UsageToken usage, AppData appData,
+                                                 std::shared_ptr<std::recursive_mutex> transportMutex);
 
 } // namespace mediasoupclient
 
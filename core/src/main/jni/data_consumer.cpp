@@ -10,6 +10,9 @@
 #include <DataConsumer.hpp>
 #include <Logger.hpp>
 
+#include "json_parser.h"
+#include "transport_lock.h"
+
 using namespace webrtc;
 
 namespace mediasoupclient
@@ -73,7 +76,7 @@ extern "C"
     return handleNativeCrash(env,
                              [&]() {
                                auto result = getDataConsumer(j_dataConsumer)->GetSctpStreamParameters();
-                               return NativeToJavaString(env, result.dump()).Release();
+                               return NativeToJavaJson(env, result).Release();
                              })
       .value_or(nullptr);
   }
@@ -120,8 +123,12 @@ extern "C"
 
     return handleNativeCrash(env,
                              [&]() {
+                               if (const auto &appData = reinterpret_cast<OwnedDataConsumer *>(j_dataConsumer)->appData(); appData.opaque())
+                               {
+                                 return appData.toJava(env).Release();
+                               }
                                auto result = getDataConsumer(j_dataConsumer)->GetAppData();
-                               return NativeToJavaString(env, result.dump()).Release();
+                               return NativeToJavaJson(env, result).Release();
                              })
       .value_or(nullptr);
   }
@@ -142,7 +149,10 @@ extern "C"
   {
     MSC_TRACE();
 
-    handleNativeCrashNoReturn(env, [&]() { getDataConsumer(j_dataConsumer)->Close(); });
+    handleNativeCrashNoReturn(env, [&]() {
+      TransportLock lock(*reinterpret_cast<OwnedDataConsumer *>(j_dataConsumer)->transportMutex());
+      getDataConsumer(j_dataConsumer)->Close();
+    });
   }
 
   JNI_DEFINE_METHOD(void, DataConsumer, nativeDispose, jlong j_dataConsumer)
@@ -181,6 +191,8 @@ void DataConsumerListenerJni::OnClose(DataConsumer *)
 {
   MSC_TRACE();
 
+  NotifyNativeClose();
+
   JNIEnv *env = AttachCurrentThreadIfNeeded();
   env->CallVoidMethod(j_listener_.obj(), dataConsumerListenerOnCloseMethod, j_dataConsumer_.obj());
 }
@@ -189,6 +201,11 @@ void DataConsumerListenerJni::OnMessage(DataConsumer *, const DataBuffer &buffer
 {
   MSC_TRACE();
 
+  if (NotifyNativeMessage(buffer))
+  {
+    return;
+  }
+
   JNIEnv *env = AttachCurrentThreadIfNeeded();
   auto byte_buffer = jni::NewDirectByteBuffer(env, const_cast<char *>(buffer.data.data<char>()), buffer.data.size());
   auto j_buffer = ScopedJavaLocalRef<jobject>(env, env->NewObject(bufferClass, bufferConstructorMethod, byte_buffer.obj(), buffer.binary));
@@ -200,20 +217,56 @@ void DataConsumerListenerJni::OnTransportClose(DataConsumer *)
 {
   MSC_TRACE();
 
+  NotifyNativeClose();
+
   JNIEnv *env = AttachCurrentThreadIfNeeded();
   env->CallVoidMethod(j_listener_.obj(), dataConsumerListenerOnTransportCloseMethod, j_dataConsumer_.obj());
 }
 
+void DataConsumerListenerJni::SetNativeListener(const mediasoup_data_consumer_listener *listener)
+{
+  std::lock_guard<std::mutex> lock(nativeListenerMutex_);
+  if (listener == nullptr)
+  {
+    nativeListener_.reset();
+  }
+  else
+  {
+    nativeListener_ = *listener;
+  }
+}
+
+bool DataConsumerListenerJni::NotifyNativeMessage(const DataBuffer &buffer)
+{
+  std::lock_guard<std::mutex> lock(nativeListenerMutex_);
+  if (!nativeListener_)
+  {
+    return false;
+  }
+  nativeListener_->on_message(nativeListener_->user_data, buffer.data.data<uint8_t>(), buffer.data.size(), buffer.binary ? 1 : 0);
+  return true;
+}
+
+void DataConsumerListenerJni::NotifyNativeClose()
+{
+  std::lock_guard<std::mutex> lock(nativeListenerMutex_);
+  if (nativeListener_ && nativeListener_->on_close != nullptr)
+  {
+    nativeListener_->on_close(nativeListener_->user_data);
+  }
+}
+
 inline DataConsumer *getDataConsumer(jlong j_dataConsumer)
 {
   return reinterpret_cast<OwnedDataConsumer *>(j_dataConsumer)->dataConsumer();
 }
 
-ScopedJavaLocalRef<jobject> NativeToJavaDataConsumer(JNIEnv *env, DataConsumer *dataConsumer, DataConsumerListenerJni *listener)
+ScopedJavaLocalRef<jobject> NativeToJavaDataConsumer(JNIEnv *env, DataConsumer *dataConsumer, DataConsumerListenerJni *listener, UsageToken usage, AppData appData,
+                                                     std::shared_ptr<std::recursive_mutex> transportMutex)
 {
   MSC_TRACE();
 
-  auto ownedDataConsumer = new OwnedDataConsumer(dataConsumer, listener);
+  auto ownedDataConsumer = new OwnedDataConsumer(dataConsumer, listener, std::move(usage), std::move(appData), std::move(transportMutex));
   auto j_dataConsumer = ScopedJavaLocalRef<jobject>(env, env->NewObject(dataConsumerClass, dataConsumerConstructorMethod, NativeToJavaPointer(ownedDataConsumer)));
   listener->SetJDataConsumer(env, j_dataConsumer);
   return j_dataConsumer;
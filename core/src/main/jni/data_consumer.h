@@ -4,9 +4,15 @@
 #include <jni.h>
 
 #include <DataConsumer.hpp>
+#include <memory>
+#include <mutex>
+#include <optional>
 
+#include "app_data.h"
+#include "device_usage.h"
 #include "jni_common.h"
 #include "jni_util.h"
+#include "mediasoup_native.h"
 
 namespace mediasoupclient
 {
@@ -54,15 +60,27 @@ public:
 public:
   void SetJDataConsumer(JNIEnv* env, const JavaRef<jobject>& j_data_consumer) { j_dataConsumer_ = j_data_consumer; }
 
+  // Messages go to |listener| instead of the Java listener while it is set.
+  void SetNativeListener(const mediasoup_data_consumer_listener* listener);
+
 private:
+  // Calls the native listener and returns true when one is set.
+  bool NotifyNativeMessage(const webrtc::DataBuffer& buffer);
+  void NotifyNativeClose();
+
   const ScopedJavaGlobalRef<jobject> j_listener_;
   ScopedJavaGlobalRef<jobject> j_dataConsumer_;
+  std::mutex nativeListenerMutex_;
+  std::optional<mediasoup_data_consumer_listener> nativeListener_;
 };
 
 class OwnedDataConsumer
 {
 public:
-  OwnedDataConsumer(DataConsumer* dataConsumer, DataConsumerListenerJni* listener) : dataConsumer_(dataConsumer), listener_(listener) {}
+  OwnedDataConsumer(DataConsumer* dataConsumer, DataConsumerListenerJni* listener, UsageToken usage, AppData appData, std::shared_ptr<std::recursive_mutex> transportMutex)
+    : dataConsumer_(dataConsumer), listener_(listener), usage_(std::move(usage)), appData_(std::move(appData)), transportMutex_(std::move(transportMutex))
+  {
+  }
 
   ~OwnedDataConsumer()
   {
@@ -71,15 +89,23 @@ public:
   }
 
   DataConsumer* dataConsumer() const { return dataConsumer_; }
+  const AppData& appData() const { return appData_; }
+  // Held around the close, which updates the transport.
+  const std::shared_ptr<std::recursive_mutex>& transportMutex() const { return transportMutex_; }
+  DataConsumerListenerJni* listener() const { return listener_; }
 
 private:
   DataConsumer* dataConsumer_;
   DataConsumerListenerJni* listener_;
+  UsageToken usage_;
+  AppData appData_;
+  const std::shared_ptr<std::recursive_mutex> transportMutex_;
 };
 
 inline DataConsumer* getDataConsumer(jlong j_dataConsumer_);
 
-ScopedJavaLocalRef<jobject> NativeToJavaDataConsumer(JNIEnv* env, DataConsumer* dataConsumer, DataConsumerListenerJni* listener);
+ScopedJavaLocalRef<jobject> NativeToJavaDataConsumer(JNIEnv* env, DataConsumer* dataConsumer, DataConsumerListenerJni* listener, UsageToken usage, AppData appData,
+                                                     std::shared_ptr<std::recursive_mutex> transportMutex);
 
 } // namespace mediasoupclient
 
@@ -9,6 +9,9 @@
 #include <DataProducer.hpp>
 #include <Logger.hpp>
 
+#include "json_parser.h"
+#include "transport_lock.h"
+
 using namespace webrtc;
 
 namespace mediasoupclient
@@ -56,7 +59,7 @@ extern "C"
     return handleNativeCrash(env,
                              [&]() {
                                auto result = getDataProducer(j_dataProducer)->GetSctpStreamParameters();
-                               return NativeToJavaString(env, result.dump()).Release();
+                               return NativeToJavaJson(env, result).Release();
                              })
       .value_or(nullptr);
   }
@@ -115,8 +118,12 @@ extern "C"
 
     return handleNativeCrash(env,
                              [&]() {
+                               if (const auto& appData = reinterpret_cast<OwnedDataProducer*>(j_dataProducer)->appData(); appData.opaque())
+                               {
+                                 return appData.toJava(env).Release();
+                               }
                                auto result = getDataProducer(j_dataProducer)->GetAppData();
-                               return NativeToJavaString(env, result.dump()).Release();
+                               return NativeToJavaJson(env, result).Release();
                              })
       .value_or(nullptr);
   }
@@ -137,7 +144,10 @@ extern "C"
   {
     MSC_TRACE();
 
-    handleNativeCrashNoReturn(env, [&]() { getDataProducer(j_dataProducer)->Close(); });
+    handleNativeCrashNoReturn(env, [&]() {
+      TransportLock lock(*reinterpret_cast<OwnedDataProducer*>(j_dataProducer)->transportMutex());
+      getDataProducer(j_dataProducer)->Close();
+    });
   }
 
   JNI_DEFINE_METHOD(void, DataProducer, nativeSend, jlong j_dataProducer, jbyteArray j_buffer, jboolean j_binary)
@@ -195,11 +205,12 @@ inline DataProducer* getDataProducer(jlong j_dataProducer)
   return reinterpret_cast<OwnedDataProducer*>(j_dataProducer)->dataProducer();
 }
 
-ScopedJavaLocalRef<jobject> NativeToJavaDataProducer(JNIEnv* env, DataProducer* dataProducer, DataProducerListenerJni* listener)
+ScopedJavaLocalRef<jobject> NativeToJavaDataProducer(JNIEnv* env, DataProducer* dataProducer, DataProducerListenerJni* listener, UsageToken usage, AppData appData,
+                                                     std::shared_ptr<std::recursive_mutex> transportMutex)
 {
   MSC_TRACE();
 
-  auto ownedDataProducer = new OwnedDataProducer(dataProducer, listener);
+  auto ownedDataProducer = new OwnedDataProducer(dataProducer, listener, std::move(usage), std::move(appData), std::move(transportMutex));
   auto j_dataProducer = ScopedJavaLocalRef<jobject>(env, env->NewObject(dataProducerClass, dataProducerConstructorMethod, NativeToJavaPointer(ownedDataProducer)));
   listener->SetJDataProducer(env, j_dataProducer);
   return j_dataProducer;
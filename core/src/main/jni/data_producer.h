@@ -4,7 +4,11 @@
 #include <jni.h>
 
 #include <DataProducer.hpp>
+#include <memory>
+#include <mutex>
 
+#include "app_data.h"
+#include "device_usage.h"
 #include "jni_common.h"
 #include "jni_util.h"
 
@@ -62,7 +66,10 @@ private:
 class OwnedDataProducer
 {
 public:
-  OwnedDataProducer(DataProducer* dataProducer, DataProducerListenerJni* listener) : dataProducer_(dataProducer), listener_(listener) {}
+  OwnedDataProducer(DataProducer* dataProducer, DataProducerListenerJni* listener, UsageToken usage, AppData appData, std::shared_ptr<std::recursive_mutex> transportMutex)
+    : dataProducer_(dataProducer), listener_(listener), usage_(std::move(usage)), appData_(std::move(appData)), transportMutex_(std::move(transportMutex))
+  {
+  }
 
   ~OwnedDataProducer()
   {
@@ -71,15 +78,22 @@ public:
   }
 
   DataProducer* dataProducer() const { return dataProducer_; }
+  const AppData& appData() const { return appData_; }
+  // Held around the close, which updates the transport.
+  const std::shared_ptr<std::recursive_mutex>& transportMutex() const { return transportMutex_; }
 
 private:
   DataProducer* dataProducer_;
   DataProducerListenerJni* listener_;
+  UsageToken usage_;
+  AppData appData_;
+  const std::shared_ptr<std::recursive_mutex> transportMutex_;
 };
 
 inline DataProducer* getDataProducer(jlong j_dataProducer);
 
-ScopedJavaLocalRef<jobject> NativeToJavaDataProducer(JNIEnv* env, DataProducer* dataProducer, DataProducerListenerJni* listener);
+ScopedJavaLocalRef<jobject> NativeToJavaDataProducer(JNIEnv* env, DataProducer* dataProducer, DataProducerListenerJni* listener, UsageToken usage, AppData appData,
+                                                     std::shared_ptr<std::recursive_mutex> transportMutex);
 
 } // namespace mediasoupclient
 
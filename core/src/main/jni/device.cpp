@@ -8,8 +8,14 @@
 
 #include <Device.hpp>
 #include <Logger.hpp>
+#include <stdexcept>
 
+#include "app_data.h"
+#include "device_usage.h"
+#include "json_parser.h"
+#include "negotiation_scope.h"
 #include "recv_transport.h"
+#include "rtp_parameters.h"
 #include "send_transport.h"
 
 using namespace webrtc;
@@ -17,16 +23,38 @@ using namespace webrtc;
 namespace mediasoupclient
 {
 
+namespace
+{
+
+std::optional<std::vector<std::string>> JavaToNativeFilter(JNIEnv* env, jobjectArray j_values)
+{
+  if (j_values == nullptr)
+  {
+    return std::nullopt;
+  }
+  std::vector<std::string> result;
+  for (jsize i = 0, length = env->GetArrayLength(j_values); i < length; ++i)
+  {
+    result.push_back(JavaToNativeString(env, ScopedJavaLocalRef<jstring>(env, static_cast<jstring>(env->GetObjectArrayElement(j_values, i)))));
+  }
+  return result;
+}
+
+} // namespace
+
 extern "C"
 {
 
-  JNI_DEFINE_METHOD(jlong, Device, nativeNewDevice)
+  JNI_DEFINE_METHOD(jlong, Device, nativeNewDevice, jboolean j_opaqueAppData)
   {
     MSC_TRACE();
 
     return handleNativeCrash(env,
                              [&]() {
-                               auto* result = new Device();
+                               // Every transport, producer and consumer comes from a Device, so callbacks are resolved here.
+                               init(env);
+                               auto* result = new OwnedDevice();
+                               result->opaqueAppData = j_opaqueAppData;
                                return NativeToJavaPointer(result);
                              })
       .value_or(0L);
@@ -36,7 +64,29 @@ extern "C"
   {
     MSC_TRACE();
 
-    delete reinterpret_cast<Device*>(j_device);
+    delete getOwnedDevice(j_device);
+  }
+
+  JNI_DEFINE_METHOD(jstring, Device, nativeGetUsage, jlong j_device)
+  {
+    MSC_TRACE();
+
+    return handleNativeCrash(env,
+                             [&]() {
+                               auto result = getOwnedDevice(j_device)->usage->toJson();
+                               return NativeToJavaJson(env, result).Release();
+                             })
+      .value_or(nullptr);
+  }
+
+  JNI_DEFINE_METHOD(void, Device, nativeSetCertificateProvider, jlong j_device, jlong j_provider)
+  {
+    MSC_TRACE();
+
+    handleNativeCrashNoReturn(env, [&]() {
+      auto* ownedDevice = getOwnedDevice(j_device);
+      ownedDevice->setCertificateProvider(j_provider == 0 ? nullptr : reinterpret_cast<OwnedCertificateProvider*>(j_provider)->provider);
+    });
   }
 
   JNI_DEFINE_METHOD(jboolean, Device, nativeIsLoaded, jlong j_device)
@@ -45,7 +95,7 @@ extern "C"
 
     return handleNativeCrash(env,
                              [&]() {
-                               auto result = reinterpret_cast<Device*>(j_device)->IsLoaded();
+                               auto result = getOwnedDevice(j_device)->device.IsLoaded();
                                return static_cast<jboolean>(result);
                              })
       .value_or(false);
@@ -57,8 +107,8 @@ extern "C"
 
     return handleNativeCrash(env,
                              [&]() {
-                               auto result = reinterpret_cast<Device*>(j_device)->GetRtpCapabilities();
-                               return NativeToJavaString(env, result.dump()).Release();
+                               auto result = getOwnedDevice(j_device)->device.GetRtpCapabilities();
+                               return NativeToJavaJson(env, result).Release();
                              })
       .value_or(nullptr);
   }
@@ -69,22 +119,56 @@ extern "C"
 
     return handleNativeCrash(env,
                              [&]() {
-                               auto result = reinterpret_cast<Device*>(j_device)->GetSctpCapabilities();
-                               return NativeToJavaString(env, result.dump()).Release();
+                               auto result = getOwnedDevice(j_device)->device.GetSctpCapabilities();
+                               return NativeToJavaJson(env, result).Release();
                              })
       .value_or(nullptr);
   }
 
   JNI_DEFINE_METHOD(void, Device, nativeLoad, jlong j_device, jstring j_routerRtpCapabilities,
-                    jobject j_configuration, jlong j_peerConnectionFactory)
+                    jobject j_configuration, jlong j_peerConnectionFactory, jobjectArray j_mimeTypes, jobjectArray j_headerExtensions, jobjectArray j_rtcpFeedback)
   {
     MSC_TRACE();
 
+    NegotiationScope scope("Device.load", getOwnedDevice(j_device)->usage.get());
+
     handleNativeCrashNoReturn(env, [&]() {
-      auto capabilities = JavaToNativeString(env, JavaParamRef<jstring>(env, j_routerRtpCapabilities));
+      // Only codecs and header extensions are consumed by ortc.
+      auto capabilities = JavaToNativeJson(env, JavaParamRef<jstring>(env, j_routerRtpCapabilities), {"codecs", "headerExtensions"});
+      rtp::CapabilityFilter filter{ JavaToNativeFilter(env, j_mimeTypes), JavaToNativeFilter(env, j_headerExtensions), JavaToNativeFilter(env, j_rtcpFeedback) };
+      if (!filter.empty())
+      {
+        // Everything derived from the capabilities, and so every SDP, only sees what is left.
+        auto typed = rtp::Capabilities::fromJson(capabilities);
+        filter.apply(typed);
+        capabilities = typed.toJson();
+      }
+      auto* ownedDevice = getOwnedDevice(j_device);
       PeerConnection::Options options;
       JavaToNativeOptions(env, JavaParamRef<jobject>(env, j_configuration), j_peerConnectionFactory, options);
-      reinterpret_cast<Device*>(j_device)->Load(json::parse(capabilities), &options);
+      // Load() probes a PeerConnection, which would generate a certificate as well.
+      applyCertificate(ownedDevice, options);
+      ownedDevice->device.Load(capabilities, &options);
+      ownedDevice->capabilities.emplace(rtp::Capabilities::fromJson(ownedDevice->device.GetRtpCapabilities()));
+    });
+  }
+
+  JNI_DEFINE_METHOD(void, Device, nativeLoadDataOnly, jlong j_device, jobject j_configuration, jlong j_peerConnectionFactory)
+  {
+    MSC_TRACE();
+
+    NegotiationScope scope("Device.loadDataOnly", getOwnedDevice(j_device)->usage.get());
+
+    handleNativeCrashNoReturn(env, [&]() {
+      auto* ownedDevice = getOwnedDevice(j_device);
+      PeerConnection::Options options;
+      JavaToNativeOptions(env, JavaParamRef<jobject>(env, j_configuration), j_peerConnectionFactory, options);
+      applyCertificate(ownedDevice, options);
+      // No codec matches, so nothing can be produced nor consumed and no media section is ever negotiated.
+      // Load() still probes the native capabilities, there is no way around it in libmediasoupclient.
+      ownedDevice->device.Load({ { "codecs", json::array() }, { "headerExtensions", json::array() } }, &options);
+      ownedDevice->dataOnly = true;
+      ownedDevice->capabilities.emplace(rtp::Capabilities());
     });
   }
 
@@ -95,24 +179,50 @@ extern "C"
     return handleNativeCrash(env,
                              [&]() {
                                auto nativeKind = JavaToNativeString(env, JavaParamRef<jstring>(env, j_kind));
-                               auto result = reinterpret_cast<Device*>(j_device)->CanProduce(nativeKind);
+                               auto* ownedDevice = getOwnedDevice(j_device);
+                               // Unloaded devices and unknown kinds get the libmediasoupclient errors.
+                               if (ownedDevice->capabilities && (nativeKind == "audio" || nativeKind == "video"))
+                               {
+                                 return static_cast<jboolean>(ownedDevice->capabilities->hasKind(nativeKind));
+                               }
+                               auto result = ownedDevice->device.CanProduce(nativeKind);
                                return static_cast<jboolean>(result);
                              })
       .value_or(false);
   }
 
+  JNI_DEFINE_METHOD(jstring, Device, nativeFindCodec, jlong j_device, jstring j_mimeType)
+  {
+    MSC_TRACE();
+
+    return handleNativeCrash(env,
+                             [&]() -> jstring {
+                               const auto& capabilities = getOwnedDevice(j_device)->capabilities;
+                               if (!capabilities)
+                               {
+                                 throw std::logic_error("not loaded");
+                               }
+                               const auto* codec = capabilities->findCodec(JavaToNativeString(env, JavaParamRef<jstring>(env, j_mimeType)));
+                               return codec ? NativeToJavaJson(env, codec->toJson()).Release() : nullptr;
+                             })
+      .value_or(nullptr);
+  }
+
   JNI_DEFINE_METHOD(jobject, Device, nativeCreateSendTransport, jlong j_device, jobject j_listener, jstring j_id, jstring j_iceParameters, jstring j_iceCandidates, jstring j_dtlsParameters,
                     jstring j_sctpParameters, jobject j_configuration, jlong j_peerConnectionFactory, jstring j_appData)
   {
     MSC_TRACE();
 
+    auto* ownedDevice = getOwnedDevice(j_device);
+    NegotiationScope scope("Device.createSendTransport", ownedDevice->usage.get());
+
     return handleNativeCrash(env,
                              [&]() {
                                auto listener = new SendTransportListenerJni(env, JavaParamRef<jobject>(env, j_listener));
                                auto id = JavaToNativeString(env, JavaParamRef<jstring>(env, j_id));
-                               auto iceParameters = JavaToNativeString(env, JavaParamRef<jstring>(env, j_iceParameters));
-                               auto iceCandidates = JavaToNativeString(env, JavaParamRef<jstring>(env, j_iceCandidates));
-                               auto dtlsParameters = JavaToNativeString(env, JavaParamRef<jstring>(env, j_dtlsParameters));
+                               auto iceParameters = JavaToNativeJson(env, JavaParamRef<jstring>(env, j_iceParameters));
+                               auto iceCandidates = JavaToNativeJson(env, JavaParamRef<jstring>(env, j_iceCandidates));
+                               auto dtlsParameters = JavaToNativeJson(env, JavaParamRef<jstring>(env, j_dtlsParameters));
                                json sctpParameters;
                                if (j_sctpParameters == nullptr)
                                {
@@ -120,20 +230,21 @@ extern "C"
                                }
                                else
                                {
-                                 sctpParameters = json::parse(JavaToNativeString(env, JavaParamRef<jstring>(env, j_sctpParameters)));
+                                 sctpParameters = JavaToNativeJson(env, JavaParamRef<jstring>(env, j_sctpParameters));
                                }
+                               AppData keptAppData(env, j_appData, ownedDevice->opaqueAppData);
                                auto appData = json::object();
-                               if (j_appData != nullptr)
+                               if (j_appData != nullptr && !keptAppData.opaque())
                                {
-                                 appData = json::parse(JavaToNativeString(env, JavaParamRef<jstring>(env, j_appData)));
+                                 appData = JavaToNativeJson(env, JavaParamRef<jstring>(env, j_appData));
                                }
 
                                PeerConnection::Options options;
                                JavaToNativeOptions(env, JavaParamRef<jobject>(env, j_configuration), j_peerConnectionFactory, options);
+                               applyCertificate(ownedDevice, options);
 
-                               auto transport = reinterpret_cast<Device*>(j_device)->CreateSendTransport(listener, id, json::parse(iceParameters), json::parse(iceCandidates),
-                                                                                                         json::parse(dtlsParameters), sctpParameters, &options, appData);
-                               return NativeToJavaSendTransport(env, transport, listener).Release();
+                               auto transport = ownedDevice->device.CreateSendTransport(listener, id, iceParameters, iceCandidates, dtlsParameters, sctpParameters, &options, appData);
+                               return NativeToJavaSendTransport(env, transport, listener, UsageToken(ownedDevice->usage, DeviceUsage::kSendTransports), std::move(keptAppData), ownedDevice->dataOnly).Release();
                              })
       .value_or(nullptr);
   }
@@ -143,13 +254,16 @@ extern "C"
   {
     MSC_TRACE();
 
+    auto* ownedDevice = getOwnedDevice(j_device);
+    NegotiationScope scope("Device.createRecvTransport", ownedDevice->usage.get());
+
     return handleNativeCrash(env,
                              [&]() {
                                auto listener = new RecvTransportListenerJni(env, JavaParamRef<jobject>(env, j_listener));
                                auto id = JavaToNativeString(env, JavaParamRef<jstring>(env, j_id));
-                               auto iceParameters = JavaToNativeString(env, JavaParamRef<jstring>(env, j_iceParameters));
-                               auto iceCandidates = JavaToNativeString(env, JavaParamRef<jstring>(env, j_iceCandidates));
-                               auto dtlsParameters = JavaToNativeString(env, JavaParamRef<jstring>(env, j_dtlsParameters));
+                               auto iceParameters = JavaToNativeJson(env, JavaParamRef<jstring>(env, j_iceParameters));
+                               auto iceCandidates = JavaToNativeJson(env, JavaParamRef<jstring>(env, j_iceCandidates));
+                               auto dtlsParameters = JavaToNativeJson(env, JavaParamRef<jstring>(env, j_dtlsParameters));
                                json sctpParameters;
                                if (j_sctpParameters == nullptr)
                                {
@@ -157,25 +271,31 @@ extern "C"
                                }
                                else
                                {
-                                 sctpParameters = json::parse(JavaToNativeString(env, JavaParamRef<jstring>(env, j_sctpParameters)));
+                                 sctpParameters = JavaToNativeJson(env, JavaParamRef<jstring>(env, j_sctpParameters));
                                }
+                               AppData keptAppData(env, j_appData, ownedDevice->opaqueAppData);
                                auto appData = json::object();
-                               if (j_appData != nullptr)
+                               if (j_appData != nullptr && !keptAppData.opaque())
                                {
-                                 appData = json::parse(JavaToNativeString(env, JavaParamRef<jstring>(env, j_appData)));
+                                 appData = JavaToNativeJson(env, JavaParamRef<jstring>(env, j_appData));
                                }
 
                                PeerConnection::Options options;
                                JavaToNativeOptions(env, JavaParamRef<jobject>(env, j_configuration), j_peerConnectionFactory, options);
+                               applyCertificate(ownedDevice, options);
 
-                               auto transport = reinterpret_cast<Device*>(j_device)->CreateRecvTransport(listener, id, json::parse(iceParameters), json::parse(iceCandidates),
-                                                                                                         json::parse(dtlsParameters), sctpParameters, &options, appData);
-                               return NativeToJavaRecvTransport(env, transport, listener).Release();
+                               auto transport = ownedDevice->device.CreateRecvTransport(listener, id, iceParameters, iceCandidates, dtlsParameters, sctpParameters, &options, appData);
+                               return NativeToJavaRecvTransport(env, transport, listener, UsageToken(ownedDevice->usage, DeviceUsage::kRecvTransports), std::move(keptAppData), ownedDevice->dataOnly).Release();
                              })
       .value_or(nullptr);
   }
 }
 
+OwnedDevice* getOwnedDevice(jlong j_device)
+{
+  return reinterpret_cast<OwnedDevice*>(j_device);
+}
+
 void JavaToNativeOptions(JNIEnv* env, const JavaRef<jobject>& j_configuration, jlong j_factory, PeerConnection::Options& options)
 {
   MSC_TRACE();
@@ -189,4 +309,19 @@ void JavaToNativeOptions(JNIEnv* env, const JavaRef<jobject>& j_configuration, j
   options.factory = reinterpret_cast<PeerConnectionFactoryInterface*>(j_factory);
 }
 
+void applyCertificate(const OwnedDevice* ownedDevice, PeerConnection::Options& options)
+{
+  MSC_TRACE();
+
+  auto provider = ownedDevice->certificateProvider();
+  if (!provider || !options.config.certificates.empty())
+  {
+    return;
+  }
+  if (auto certificate = provider->certificate())
+  {
+    options.config.certificates.push_back(certificate);
+  }
+}
+
 } // namespace mediasoupclient
\ No newline at end of file
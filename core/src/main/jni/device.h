@@ -6,7 +6,12 @@
 
 #include <Device.hpp>
 #include <PeerConnection.hpp>
+#include <memory>
+#include <mutex>
 
+#include "certificate_provider.h"
+#include "device_usage.h"
+#include "rtp_parameters.h"
 #include "jni_common.h"
 #include "jni_util.h"
 
@@ -16,10 +21,14 @@ namespace mediasoupclient
 extern "C"
 {
 
-  JNI_DEFINE_METHOD(jlong, Device, nativeNewDevice);
+  JNI_DEFINE_METHOD(jlong, Device, nativeNewDevice, jboolean j_opaqueAppData);
 
   JNI_DEFINE_METHOD(void, Device, nativeDispose, jlong j_device);
 
+  JNI_DEFINE_METHOD(jstring, Device, nativeGetUsage, jlong j_device);
+
+  JNI_DEFINE_METHOD(void, Device, nativeSetCertificateProvider, jlong j_device, jlong j_provider);
+
   JNI_DEFINE_METHOD(jboolean, Device, nativeIsLoaded, jlong j_device);
 
   JNI_DEFINE_METHOD(jstring, Device, nativeGetRtpCapabilities, jlong j_device);
@@ -27,10 +36,14 @@ extern "C"
   JNI_DEFINE_METHOD(jstring, Device, nativeGetSctpCapabilities, jlong j_device);
 
   JNI_DEFINE_METHOD(void, Device, nativeLoad, jlong j_device, jstring j_routerRtpCapabilities,
-                    jobject j_configuration, jlong j_peerConnectionFactory);
+                    jobject j_configuration, jlong j_peerConnectionFactory, jobjectArray j_mimeTypes, jobjectArray j_headerExtensions, jobjectArray j_rtcpFeedback);
+
+  JNI_DEFINE_METHOD(void, Device, nativeLoadDataOnly, jlong j_device, jobject j_configuration, jlong j_peerConnectionFactory);
 
   JNI_DEFINE_METHOD(jboolean, Device, nativeCanProduce, jlong j_device, jstring j_kind);
 
+  JNI_DEFINE_METHOD(jstring, Device, nativeFindCodec, jlong j_device, jstring j_mimeType);
+
   JNI_DEFINE_METHOD(jobject, Device, nativeCreateSendTransport, jlong j_device, jobject j_listener, jstring j_id, jstring j_iceParameters, jstring j_iceCandidates, jstring j_dtlsParameters,
                     jstring j_sctpParameters, jobject j_configuration, jlong j_peerConnectionFactory, jstring j_appData);
 
@@ -38,8 +51,43 @@ extern "C"
                     jstring j_sctpParameters, jobject j_configuration, jlong j_peerConnectionFactory, jstring j_appData);
 }
 
+// Device plus the usage shared with the transports, producers and consumers created from it.
+struct OwnedDevice
+{
+  Device device;
+  const std::shared_ptr<DeviceUsage> usage = std::make_shared<DeviceUsage>();
+  // appData of everything created from this Device is kept as the given string, see AppData.
+  bool opaqueAppData{ false };
+  // Set once loaded.
+  std::optional<rtp::CapabilityIndex> capabilities;
+  // Loaded without media capabilities, see nativeLoadDataOnly.
+  bool dataOnly{ false };
+
+  // Replaced from Java while transports are being created on other threads.
+  void setCertificateProvider(std::shared_ptr<CertificateProvider> provider)
+  {
+    std::lock_guard<std::mutex> lock(certificateProviderMutex_);
+    certificateProvider_ = std::move(provider);
+  }
+
+  std::shared_ptr<CertificateProvider> certificateProvider() const
+  {
+    std::lock_guard<std::mutex> lock(certificateProviderMutex_);
+    return certificateProvider_;
+  }
+
+private:
+  mutable std::mutex certificateProviderMutex_;
+  std::shared_ptr<CertificateProvider> certificateProvider_;
+};
+
+OwnedDevice* getOwnedDevice(jlong j_device);
+
 void JavaToNativeOptions(JNIEnv* env, const JavaRef<jobject>& configuration, jlong factory, PeerConnection::Options& options);
 
+// Hands a certificate of the Device provider to the PeerConnection, unless the configuration brings its own.
+void applyCertificate(const OwnedDevice* ownedDevice, PeerConnection::Options& options);
+
 } // namespace mediasoupclient
 
 #endif // DEVICE_H_
\ No newline at end of file
@@ -0,0 +1,24 @@
+#define MSC_CLASS "device_usage"
+
+#include "device_usage.h"
+
+namespace mediasoupclient
+{
+
+json DeviceUsage::toJson() const
+{
+  auto counter = [this](Counter c) { return counters_[c].load(std::memory_order_relaxed); };
+
+  return {
+    { "sendTransports", counter(kSendTransports) },
+    { "recvTransports", counter(kRecvTransports) },
+    { "producers", counter(kProducers) },
+    { "consumers", counter(kConsumers) },
+    { "dataProducers", counter(kDataProducers) },
+    { "dataConsumers", counter(kDataConsumers) },
+    { "negotiations", negotiations_.load(std::memory_order_relaxed) },
+    { "negotiationMicros", negotiationNanos_.load(std::memory_order_relaxed) / 1000 },
+  };
+}
+
+} // namespace mediasoupclient
@@ -0,0 +1,83 @@
+#ifndef DEVICE_USAGE_H_
+#define DEVICE_USAGE_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "jni_common.h"
+
+namespace mediasoupclient
+{
+
+// Live objects and negotiation time of one Device.
+// Shared by the Device and everything created from it, so Devices on the same PeerConnectionFactory can be told apart.
+class DeviceUsage final
+{
+public:
+  enum Counter
+  {
+    kSendTransports,
+    kRecvTransports,
+    kProducers,
+    kConsumers,
+    kDataProducers,
+    kDataConsumers,
+    kCounterCount,
+  };
+
+  void add(Counter counter, int64_t delta) { counters_[counter].fetch_add(delta, std::memory_order_relaxed); }
+
+  // Not behind MSC_NEGOTIATION_STATS: Device.usage is public API and always reports the negotiation time,
+  // which costs two relaxed atomic adds next to a negotiation of a millisecond or more.
+  void addNegotiation(int64_t elapsedNanos)
+  {
+    negotiations_.fetch_add(1, std::memory_order_relaxed);
+    negotiationNanos_.fetch_add(elapsedNanos, std::memory_order_relaxed);
+  }
+
+  json toJson() const;
+
+private:
+  std::array<std::atomic<int64_t>, kCounterCount> counters_{};
+  std::atomic<uint64_t> negotiations_{ 0 };
+  std::atomic<int64_t> negotiationNanos_{ 0 };
+};
+
+// Keeps one counter of a DeviceUsage incremented for its lifetime.
+class UsageToken final
+{
+public:
+  UsageToken() = default;
+  UsageToken(std::shared_ptr<DeviceUsage> usage, DeviceUsage::Counter counter) : usage_(std::move(usage)), counter_(counter)
+  {
+    if (usage_)
+    {
+      usage_->add(counter_, 1);
+    }
+  }
+
+  ~UsageToken()
+  {
+    if (usage_)
+    {
+      usage_->add(counter_, -1);
+    }
+  }
+
+  UsageToken(UsageToken&& other) noexcept : usage_(std::move(other.usage_)), counter_(other.counter_) {}
+  UsageToken(const UsageToken&) = delete;
+  UsageToken& operator=(const UsageToken&) = delete;
+  UsageToken& operator=(UsageToken&&) = delete;
+
+  const std::shared_ptr<DeviceUsage>& usage() const { return usage_; }
+
+private:
+  std::shared_ptr<DeviceUsage> usage_;
+  DeviceUsage::Counter counter_{ DeviceUsage::kCounterCount };
+};
+
+} // namespace mediasoupclient
+
+#endif // DEVICE_USAGE_H_
@@ -0,0 +1,91 @@
+#ifndef MEDIASOUP_NATIVE_H_
+#define MEDIASOUP_NATIVE_H_
+
+/*
+ * C API for native code that exchanges DataChannel messages and reads media without going through the JVM.
+ *
+ * Handles are the values of the nativeHandle properties of DataConsumer, DataProducer, AudioSink and VideoThumbnailSink
+ * on the Kotlin side.
+ * They stay valid until dispose() is called on the Kotlin object, which must not happen while a call below is running.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEDIASOUP_NATIVE_EXPORT __attribute__((visibility("default")))
+
+/* Return values. */
+#define MEDIASOUP_NATIVE_OK 0
+#define MEDIASOUP_NATIVE_INVALID_ARGUMENT (-1)
+#define MEDIASOUP_NATIVE_FAILED (-2)
+
+typedef struct mediasoup_data_consumer_listener
+{
+  /* Called on the network thread for every message; |data| is only valid during the call. */
+  void (*on_message)(void* user_data, const uint8_t* data, size_t size, int binary);
+  /* Called when the DataConsumer or its transport is closed. May be NULL. */
+  void (*on_close)(void* user_data);
+  void* user_data;
+} mediasoup_data_consumer_listener;
+
+/*
+ * Deliver the messages of a DataConsumer to |listener| instead of DataConsumer.Listener.onMessage.
+ * Other events are still sent to the Kotlin listener. Pass NULL to go back to the Kotlin listener.
+ * The listener is copied. Once this returns the previous one is no longer called,
+ * so the callbacks must not call this function themselves.
+ */
+MEDIASOUP_NATIVE_EXPORT int mediasoup_data_consumer_set_listener(int64_t data_consumer, const mediasoup_data_consumer_listener* listener);
+
+/* Send a message on a DataProducer. |data| is copied before this returns. */
+MEDIASOUP_NATIVE_EXPORT int mediasoup_data_producer_send(int64_t data_producer, const uint8_t* data, size_t size, int binary);
+
+/* Bytes queued in the DataProducer, or a negative value on failure. */
+MEDIASOUP_NATIVE_EXPORT int64_t mediasoup_data_producer_buffered_amount(int64_t data_producer);
+
+/* The AudioSink and VideoThumbnailSink functions below are not in libmediasoupclient_data_so.so. */
+
+/* Interleaved samples in one 10 ms frame of an AudioSink, or 0 for an invalid handle. */
+MEDIASOUP_NATIVE_EXPORT size_t mediasoup_audio_sink_frame_samples(int64_t audio_sink);
+
+/*
+ * Copy up to |max_frames| 10 ms frames of 16 bit interleaved PCM from an AudioSink into |dst|.
+ * Returns the number of frames copied, or a negative value on failure. Never blocks.
+ * Only one thread may read from a sink at a time.
+ */
+MEDIASOUP_NATIVE_EXPORT int64_t mediasoup_audio_sink_read(int64_t audio_sink, int16_t* dst, size_t max_frames);
+
+typedef struct mediasoup_i420_frame
+{
+  const uint8_t* data_y;
+  const uint8_t* data_u;
+  const uint8_t* data_v;
+  int stride_y;
+  int stride_u;
+  int stride_v;
+  int width;
+  int height;
+  /* Clockwise rotation to apply when rendering, in degrees. */
+  int rotation;
+  int64_t timestamp_us;
+  /* Owned by the frame, released by mediasoup_i420_frame_release(). */
+  void* buffer;
+} mediasoup_i420_frame;
+
+/*
+ * Take the latest thumbnail of a VideoThumbnailSink.
+ * Returns 1 and fills |frame| when there is one, 0 when there is none, or a negative value on failure.
+ * The frame must be released to give its buffer back to the pool of the sink.
+ */
+MEDIASOUP_NATIVE_EXPORT int mediasoup_video_thumbnail_sink_poll(int64_t thumbnail_sink, mediasoup_i420_frame* frame);
+
+MEDIASOUP_NATIVE_EXPORT void mediasoup_i420_frame_release(mediasoup_i420_frame* frame);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEDIASOUP_NATIVE_H_ */
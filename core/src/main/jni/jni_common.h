@@ -9,7 +9,8 @@
 
 #define JNI_METHOD_NAME(className, methodName) Java_io_github_crow_1misia_mediasoup_##className##_##methodName
 
-#define JNI_DEFINE_METHOD(type, className, methodName, args...) JNIEXPORT type JNICALL JNI_METHOD_NAME(className, methodName)(JNIEnv * env, jobject, ##args)
+// Bridge functions are not exported, they are bound with RegisterNatives in JNI_OnLoad.
+#define JNI_DEFINE_METHOD(type, className, methodName, args...) type JNICALL JNI_METHOD_NAME(className, methodName)(JNIEnv * env, jobject, ##args)
 
 namespace mediasoupclient
 {
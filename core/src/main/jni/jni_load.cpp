@@ -4,8 +4,258 @@
 
 #include <mediasoupclient.hpp>
 
+#include "data_consumer.h"
+#include "data_producer.h"
+#include "certificate_provider.h"
+#include "device.h"
 #include "jni_common.h"
 #include "jni_util.h"
+#include "logger.h"
+#include "negotiation_stats.h"
+#include "recv_transport.h"
+#include "send_transport.h"
+#include "thread_policy.h"
+#include "transport.h"
+#ifndef MSC_DATA_ONLY
+#include "active_speaker_detector.h"
+#include "audio_sink.h"
+#include "consumer.h"
+#include "producer.h"
+#include "simulcast_controller.h"
+#include "video_thumbnail_sink.h"
+#include "visibility_scheduler.h"
+#endif
+
+#define NATIVE_METHOD(className, methodName, signature) { #methodName, signature, reinterpret_cast<void *>(&JNI_METHOD_NAME(className, methodName)) }
+
+#define STRING "Ljava/lang/String;"
+#define BYTE_BUFFER "Ljava/nio/ByteBuffer;"
+#define RTC_CONFIGURATION "Lorg/webrtc/PeerConnection$RTCConfiguration;"
+
+namespace mediasoupclient
+{
+
+namespace
+{
+
+// clang-format off
+const JNINativeMethod deviceMethods[] = {
+  NATIVE_METHOD(Device, nativeNewDevice, "(Z)J"),
+  NATIVE_METHOD(Device, nativeDispose, "(J)V"),
+  NATIVE_METHOD(Device, nativeGetUsage, "(J)" STRING),
+  NATIVE_METHOD(Device, nativeSetCertificateProvider, "(JJ)V"),
+  NATIVE_METHOD(Device, nativeIsLoaded, "(J)Z"),
+  NATIVE_METHOD(Device, nativeGetRtpCapabilities, "(J)" STRING),
+  NATIVE_METHOD(Device, nativeGetSctpCapabilities, "(J)" STRING),
+  NATIVE_METHOD(Device, nativeLoad, "(J" STRING RTC_CONFIGURATION "J[" STRING "[" STRING "[" STRING ")V"),
+  NATIVE_METHOD(Device, nativeLoadDataOnly, "(J" RTC_CONFIGURATION "J)V"),
+  NATIVE_METHOD(Device, nativeCanProduce, "(J" STRING ")Z"),
+  NATIVE_METHOD(Device, nativeFindCodec, "(J" STRING ")" STRING),
+  NATIVE_METHOD(Device, nativeCreateSendTransport,
+                "(J" CLASS_NAME_FOR_PARAMETER(SendTransport$Listener) STRING STRING STRING STRING STRING RTC_CONFIGURATION "J" STRING ")" CLASS_NAME_FOR_PARAMETER(SendTransport)),
+  NATIVE_METHOD(Device, nativeCreateRecvTransport,
+                "(J" CLASS_NAME_FOR_PARAMETER(RecvTransport$Listener) STRING STRING STRING STRING STRING RTC_CONFIGURATION "J" STRING ")" CLASS_NAME_FOR_PARAMETER(RecvTransport)),
+};
+
+const JNINativeMethod dtlsCertificateProviderMethods[] = {
+  NATIVE_METHOD(DtlsCertificateProvider, nativeNew, "(J)J"),
+  NATIVE_METHOD(DtlsCertificateProvider, nativeExportPem, "(J)[" STRING),
+  NATIVE_METHOD(DtlsCertificateProvider, nativeImportPem, "(J" STRING STRING ")V"),
+  NATIVE_METHOD(DtlsCertificateProvider, nativeGetMetrics, "(J)" STRING),
+  NATIVE_METHOD(DtlsCertificateProvider, nativeDispose, "(J)V"),
+};
+
+const JNINativeMethod transportMethods[] = {
+  NATIVE_METHOD(Transport, nativeGetId, "(J)" STRING),
+  NATIVE_METHOD(Transport, nativeIsClosed, "(J)Z"),
+  NATIVE_METHOD(Transport, nativeGetConnectionState, "(J)" STRING),
+  NATIVE_METHOD(Transport, nativeGetAppData, "(J)" STRING),
+  NATIVE_METHOD(Transport, nativeClose, "(J)V"),
+  NATIVE_METHOD(Transport, nativeGetStats, "(J)" STRING),
+  NATIVE_METHOD(Transport, nativeRestartIce, "(J" STRING ")V"),
+  NATIVE_METHOD(Transport, nativeUpdateIceServers, "(J" STRING ")V"),
+  NATIVE_METHOD(Transport, nativeDispose, "(J)V"),
+};
+
+const JNINativeMethod sendTransportMethods[] = {
+  NATIVE_METHOD(SendTransport, nativeProduce,
+                "(J" CLASS_NAME_FOR_PARAMETER(Producer$Listener) "J[Lorg/webrtc/RtpParameters$Encoding;" STRING STRING STRING ")" CLASS_NAME_FOR_PARAMETER(Producer)),
+  NATIVE_METHOD(SendTransport, nativeProduceData,
+                "(J" CLASS_NAME_FOR_PARAMETER(DataProducer$Listener) STRING STRING "ZII" STRING ")" CLASS_NAME_FOR_PARAMETER(DataProducer)),
+};
+
+const JNINativeMethod recvTransportMethods[] = {
+  NATIVE_METHOD(RecvTransport, nativeConsumeData,
+                "(J" CLASS_NAME_FOR_PARAMETER(DataConsumer$Listener) STRING STRING "I" STRING STRING STRING ")" CLASS_NAME_FOR_PARAMETER(DataConsumer)),
+  NATIVE_METHOD(RecvTransport, nativeConsume,
+                "(J" CLASS_NAME_FOR_PARAMETER(Consumer$Listener) STRING STRING STRING STRING STRING ")" CLASS_NAME_FOR_PARAMETER(Consumer)),
+  NATIVE_METHOD(RecvTransport, nativeSwapConsumer,
+                "(JJ" CLASS_NAME_FOR_PARAMETER(Consumer$Listener) STRING STRING STRING STRING STRING ")" CLASS_NAME_FOR_PARAMETER(Consumer)),
+  NATIVE_METHOD(RecvTransport, nativeCreateActiveSpeakerDetector, "(J" CLASS_NAME_FOR_PARAMETER(ActiveSpeakerDetector$Listener) "IDIII)J"),
+  NATIVE_METHOD(RecvTransport, nativeCreateVisibilityScheduler, "(J" CLASS_NAME_FOR_PARAMETER(VisibilityScheduler$Listener) "I[I)J"),
+};
+
+#ifndef MSC_DATA_ONLY
+const JNINativeMethod activeSpeakerDetectorMethods[] = {
+  NATIVE_METHOD(ActiveSpeakerDetector, nativeDispose, "(J)V"),
+};
+
+const JNINativeMethod visibilitySchedulerMethods[] = {
+  NATIVE_METHOD(VisibilityScheduler, nativeSetVisibility, "(JJZII)V"),
+  NATIVE_METHOD(VisibilityScheduler, nativeRemove, "(JJ)V"),
+  NATIVE_METHOD(VisibilityScheduler, nativeGetMetrics, "(J)" STRING),
+  NATIVE_METHOD(VisibilityScheduler, nativeDispose, "(J)V"),
+};
+
+const JNINativeMethod producerMethods[] = {
+  NATIVE_METHOD(Producer, nativeGetId, "(J)" STRING),
+  NATIVE_METHOD(Producer, nativeGetLocalId, "(J)" STRING),
+  NATIVE_METHOD(Producer, nativeIsClosed, "(J)Z"),
+  NATIVE_METHOD(Producer, nativeGetKind, "(J)" STRING),
+  NATIVE_METHOD(Producer, nativeGetRtpSender, "(J)J"),
+  NATIVE_METHOD(Producer, nativeGetTrack, "(J)J"),
+  NATIVE_METHOD(Producer, nativeGetRtpParameters, "(J)" STRING),
+  NATIVE_METHOD(Producer, nativeIsPaused, "(J)Z"),
+  NATIVE_METHOD(Producer, nativeGetMaxSpatialLayer, "(J)I"),
+  NATIVE_METHOD(Producer, nativeGetAppData, "(J)" STRING),
+  NATIVE_METHOD(Producer, nativeClose, "(J)V"),
+  NATIVE_METHOD(Producer, nativeGetStats, "(J)" STRING),
+  NATIVE_METHOD(Producer, nativePause, "(J)V"),
+  NATIVE_METHOD(Producer, nativeResume, "(J)V"),
+  NATIVE_METHOD(Producer, nativeReplaceTrack, "(JJ)V"),
+  NATIVE_METHOD(Producer, nativeSetMaxSpatialLayer, "(JI)V"),
+  NATIVE_METHOD(Producer, nativeSetEncodings, "(J[Lorg/webrtc/RtpParameters$Encoding;)V"),
+  NATIVE_METHOD(Producer, nativeCreateSimulcastController, "(JIDII)J"),
+  NATIVE_METHOD(Producer, nativeDispose, "(J)V"),
+};
+
+const JNINativeMethod simulcastControllerMethods[] = {
+  NATIVE_METHOD(SimulcastController, nativeGetMetrics, "(J)" STRING),
+  NATIVE_METHOD(SimulcastController, nativeDispose, "(J)V"),
+};
+
+const JNINativeMethod consumerMethods[] = {
+  NATIVE_METHOD(Consumer, nativeGetId, "(J)" STRING),
+  NATIVE_METHOD(Consumer, nativeGetLocalId, "(J)" STRING),
+  NATIVE_METHOD(Consumer, nativeGetProducerId, "(J)" STRING),
+  NATIVE_METHOD(Consumer, nativeIsClosed, "(J)Z"),
+  NATIVE_METHOD(Consumer, nativeGetKind, "(J)" STRING),
+  NATIVE_METHOD(Consumer, nativeGetRtpReceiver, "(J)J"),
+  NATIVE_METHOD(Consumer, nativeGetTrack, "(J)J"),
+  NATIVE_METHOD(Consumer, nativeGetRtpParameters, "(J)" STRING),
+  NATIVE_METHOD(Consumer, nativeIsPaused, "(J)Z"),
+  NATIVE_METHOD(Consumer, nativeGetAppData, "(J)" STRING),
+  NATIVE_METHOD(Consumer, nativeClose, "(J)V"),
+  NATIVE_METHOD(Consumer, nativeGetStats, "(J)" STRING),
+  NATIVE_METHOD(Consumer, nativePause, "(J)V"),
+  NATIVE_METHOD(Consumer, nativeResume, "(J)V"),
+  NATIVE_METHOD(Consumer, nativeDispose, "(J)V"),
+  NATIVE_METHOD(Consumer, nativeAddAudioSink, "(JIII)J"),
+  NATIVE_METHOD(Consumer, nativeAddThumbnailSink, "(JIII)J"),
+};
+
+const JNINativeMethod audioSinkMethods[] = {
+  NATIVE_METHOD(AudioSink, nativeRead, "(J" BYTE_BUFFER "II)I"),
+  NATIVE_METHOD(AudioSink, nativeGetAvailableFrames, "(J)I"),
+  NATIVE_METHOD(AudioSink, nativeGetDroppedFrames, "(J)J"),
+  NATIVE_METHOD(AudioSink, nativeDispose, "(J)V"),
+};
+
+const JNINativeMethod videoThumbnailSinkMethods[] = {
+  NATIVE_METHOD(VideoThumbnailSink, nativePoll, "(J)Lorg/webrtc/VideoFrame;"),
+  NATIVE_METHOD(VideoThumbnailSink, nativeGetCpuTimeNanos, "(J)J"),
+  NATIVE_METHOD(VideoThumbnailSink, nativeGetDeliveredFrames, "(J)J"),
+  NATIVE_METHOD(VideoThumbnailSink, nativeGetDroppedFrames, "(J)J"),
+  NATIVE_METHOD(VideoThumbnailSink, nativeDispose, "(J)V"),
+};
+#endif
+
+const JNINativeMethod dataProducerMethods[] = {
+  NATIVE_METHOD(DataProducer, nativeGetId, "(J)" STRING),
+  NATIVE_METHOD(DataProducer, nativeGetLocalId, "(J)" STRING),
+  NATIVE_METHOD(DataProducer, nativeGetSctpStreamParameters, "(J)" STRING),
+  NATIVE_METHOD(DataProducer, nativeGetReadyState, "(J)I"),
+  NATIVE_METHOD(DataProducer, nativeGetLabel, "(J)" STRING),
+  NATIVE_METHOD(DataProducer, nativeGetProtocol, "(J)" STRING),
+  NATIVE_METHOD(DataProducer, nativeGetBufferedAmount, "(J)J"),
+  NATIVE_METHOD(DataProducer, nativeGetAppData, "(J)" STRING),
+  NATIVE_METHOD(DataProducer, nativeIsClosed, "(J)Z"),
+  NATIVE_METHOD(DataProducer, nativeClose, "(J)V"),
+  NATIVE_METHOD(DataProducer, nativeSend, "(J[BZ)V"),
+  NATIVE_METHOD(DataProducer, nativeDispose, "(J)V"),
+};
+
+const JNINativeMethod dataConsumerMethods[] = {
+  NATIVE_METHOD(DataConsumer, nativeGetId, "(J)" STRING),
+  NATIVE_METHOD(DataConsumer, nativeGetLocalId, "(J)" STRING),
+  NATIVE_METHOD(DataConsumer, nativeGetDataProducerId, "(J)" STRING),
+  NATIVE_METHOD(DataConsumer, nativeGetSctpStreamParameters, "(J)" STRING),
+  NATIVE_METHOD(DataConsumer, nativeGetReadyState, "(J)I"),
+  NATIVE_METHOD(DataConsumer, nativeGetLabel, "(J)" STRING),
+  NATIVE_METHOD(DataConsumer, nativeGetProtocol, "(J)" STRING),
+  NATIVE_METHOD(DataConsumer, nativeGetAppData, "(J)" STRING),
+  NATIVE_METHOD(DataConsumer, nativeIsClosed, "(J)Z"),
+  NATIVE_METHOD(DataConsumer, nativeClose, "(J)V"),
+  NATIVE_METHOD(DataConsumer, nativeDispose, "(J)V"),
+};
+
+const JNINativeMethod loggerMethods[] = {
+  NATIVE_METHOD(Logger, nativeSetHandler, "(" CLASS_NAME_FOR_PARAMETER(Logger$LogHandlerInterface) ")J"),
+  NATIVE_METHOD(Logger, nativeSetLogLevel, "(I)V"),
+  NATIVE_METHOD(Logger, nativeDispose, "(J)V"),
+};
+
+const JNINativeMethod negotiationStatsMethods[] = {
+  NATIVE_METHOD(NegotiationStats, nativeGetStats, "()" STRING),
+  NATIVE_METHOD(NegotiationStats, nativeReset, "()V"),
+};
+
+const JNINativeMethod threadPolicyMethods[] = {
+  NATIVE_METHOD(ThreadPolicy, nativeApply, "(JIJII)Z"),
+  NATIVE_METHOD(ThreadPolicy, nativeMeasureQueueDelay, "(JI)J"),
+};
+// clang-format on
+
+template <size_t N>
+bool registerClassNatives(JNIEnv *env, const char *className, const JNINativeMethod (&methods)[N])
+{
+  ScopedJavaLocalRef<jclass> clazz(env, env->FindClass(className));
+  CHECK_EXCEPTION(env) << "error during FindClass: " << className;
+  if (clazz.is_null())
+  {
+    return false;
+  }
+  return env->RegisterNatives(clazz.obj(), methods, static_cast<jint>(N)) == JNI_OK;
+}
+
+#ifndef MSC_DATA_ONLY
+// Producer and Consumer bridges, left out of the data-only build.
+bool registerMediaNatives(JNIEnv *env)
+{
+  return registerClassNatives(env, WITH_PACKAGE_NAME(ActiveSpeakerDetector), activeSpeakerDetectorMethods) &&
+         registerClassNatives(env, WITH_PACKAGE_NAME(VisibilityScheduler), visibilitySchedulerMethods) &&
+         registerClassNatives(env, WITH_PACKAGE_NAME(Producer), producerMethods) && registerClassNatives(env, WITH_PACKAGE_NAME(Consumer), consumerMethods) &&
+         registerClassNatives(env, WITH_PACKAGE_NAME(SimulcastController), simulcastControllerMethods) &&
+         registerClassNatives(env, WITH_PACKAGE_NAME(AudioSink), audioSinkMethods) && registerClassNatives(env, WITH_PACKAGE_NAME(VideoThumbnailSink), videoThumbnailSinkMethods);
+}
+#endif
+
+} // namespace
+
+bool registerNatives(JNIEnv *env)
+{
+  return registerClassNatives(env, WITH_PACKAGE_NAME(Device), deviceMethods) &&
+         registerClassNatives(env, WITH_PACKAGE_NAME(DtlsCertificateProvider), dtlsCertificateProviderMethods) && registerClassNatives(env, WITH_PACKAGE_NAME(Transport), transportMethods) &&
+         registerClassNatives(env, WITH_PACKAGE_NAME(SendTransport), sendTransportMethods) && registerClassNatives(env, WITH_PACKAGE_NAME(RecvTransport), recvTransportMethods) &&
+#ifndef MSC_DATA_ONLY
+         registerMediaNatives(env) &&
+#endif
+         registerClassNatives(env, WITH_PACKAGE_NAME(DataProducer), dataProducerMethods) && registerClassNatives(env, WITH_PACKAGE_NAME(DataConsumer), dataConsumerMethods) &&
+         registerClassNatives(env, WITH_PACKAGE_NAME(Logger), loggerMethods) && registerClassNatives(env, WITH_PACKAGE_NAME(NegotiationStats), negotiationStatsMethods) &&
+         registerClassNatives(env, WITH_PACKAGE_NAME(ThreadPolicy), threadPolicyMethods);
+}
+
+} // namespace mediasoupclient
 
 extern "C"
 {
@@ -16,7 +266,11 @@ extern "C"
 
     JNIEnv *env = webrtc::jni::GetEnv();
 
-    mediasoupclient::init(env);
+    // Classes and method IDs used for callbacks are resolved on first use, see mediasoupclient::init().
+    if (!mediasoupclient::registerNatives(env))
+    {
+      return JNI_ERR;
+    }
 
     mediasoupclient::Initialize();
 
@@ -24,4 +278,4 @@ extern "C"
   }
 
   extern "C" void JNIEXPORT JNICALL JNI_OnUnload(JavaVM *jvm, void *reserved) { mediasoupclient::Cleanup(); }
-}
\ No newline at end of file
+}
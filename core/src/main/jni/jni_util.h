@@ -13,8 +13,13 @@ namespace mediasoupclient
 #define WITH_PACKAGE_NAME(className) "io/github/crow_misia/mediasoup/" #className
 #define CLASS_NAME_FOR_PARAMETER(className) "L" WITH_PACKAGE_NAME(className) ";"
 
+// Resolves the classes and method IDs used to call back into Java.
+// Only the first call does the work. It must run on a Java thread so that FindClass sees the application class loader.
 void init(JNIEnv *env);
 
+// Binds the native methods of all bridged classes. Called from JNI_OnLoad.
+bool registerNatives(JNIEnv *env);
+
 inline jclass findClass(JNIEnv *env, const std::string &name)
 {
   jclass localRef = env->FindClass(name.c_str());
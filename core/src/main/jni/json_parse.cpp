@@ -0,0 +1,150 @@
+#define MSC_CLASS "json_parse"
+
+#include "json_parse.h"
+
+#include <Logger.hpp>
+#include <string>
+
+#ifdef MSC_USE_SIMDJSON
+#include <simdjson.h>
+#endif
+
+using json = nlohmann::json;
+
+namespace mediasoupclient
+{
+
+namespace
+{
+
+json parseWithNlohmann(std::string_view text, std::initializer_list<const char*> fields)
+{
+  auto document = json::parse(text.begin(), text.end());
+  if (fields.size() == 0 || !document.is_object())
+  {
+    return document;
+  }
+
+  auto result = json::object();
+  for (auto field : fields)
+  {
+    auto it = document.find(field);
+    if (it != document.end())
+    {
+      result[field] = std::move(*it);
+    }
+  }
+  return result;
+}
+
+#ifdef MSC_USE_SIMDJSON
+json toJson(simdjson::dom::element element)
+{
+  switch (element.type())
+  {
+    case simdjson::dom::element_type::ARRAY:
+    {
+      auto result = json::array();
+      for (auto child : simdjson::dom::array(element))
+      {
+        result.push_back(toJson(child));
+      }
+      return result;
+    }
+    case simdjson::dom::element_type::OBJECT:
+    {
+      auto result = json::object();
+      for (auto member : simdjson::dom::object(element))
+      {
+        result[std::string(member.key)] = toJson(member.value);
+      }
+      return result;
+    }
+    case simdjson::dom::element_type::INT64:
+    {
+      // nlohmann stores non-negative integers as unsigned, keep the same representation.
+      auto value = int64_t(element);
+      return value >= 0 ? json(static_cast<uint64_t>(value)) : json(value);
+    }
+    case simdjson::dom::element_type::UINT64:
+      return json(uint64_t(element));
+    case simdjson::dom::element_type::DOUBLE:
+      return json(double(element));
+    case simdjson::dom::element_type::STRING:
+      return json(std::string(std::string_view(element)));
+    case simdjson::dom::element_type::BOOL:
+      return json(bool(element));
+    case simdjson::dom::element_type::NULL_VALUE:
+      return json(nullptr);
+  }
+  return json();
+}
+
+json parseWithSimdjson(std::string_view text, std::initializer_list<const char*> fields)
+{
+  // The parser keeps its buffers between calls made on the same thread.
+  thread_local simdjson::dom::parser parser;
+
+  simdjson::dom::element document = parser.parse(text.data(), text.size());
+  if (fields.size() == 0 || !document.is_object())
+  {
+    return toJson(document);
+  }
+
+  auto result = json::object();
+  simdjson::dom::object object(document);
+  for (auto field : fields)
+  {
+    simdjson::dom::element value;
+    if (object.at_key(field).get(value) == simdjson::SUCCESS)
+    {
+      result[field] = toJson(value);
+    }
+  }
+  return result;
+}
+#endif
+
+} // namespace
+
+json parseJson(std::string_view text, std::initializer_list<const char*> fields)
+{
+#ifdef MSC_USE_SIMDJSON
+#ifdef MSC_VERIFY_JSON_PARSER
+  // nlohmann decides whether the document is valid, simdjson only has to agree with it.
+  auto expected = parseWithNlohmann(text, fields);
+  json result;
+  try
+  {
+    result = parseWithSimdjson(text, fields);
+  }
+  catch (const simdjson::simdjson_error& error)
+  {
+    MSC_WARN("simdjson failed (%s), using nlohmann result [json:%.*s]", error.what(), static_cast<int>(text.size()), text.data());
+    return expected;
+  }
+  if (result != expected)
+  {
+    MSC_WARN("simdjson result differs from nlohmann, using nlohmann result [json:%.*s]", static_cast<int>(text.size()), text.data());
+    return expected;
+  }
+  return result;
+#else
+  try
+  {
+    return parseWithSimdjson(text, fields);
+  }
+  catch (const simdjson::simdjson_error& error)
+  {
+    // Documents nlohmann accepts, such as integers beyond 64 bits or deeper nesting, still parse.
+    // Invalid ones fail there with the usual nlohmann exception.
+    MSC_WARN("simdjson failed (%s), parsing with nlohmann", error.what());
+    return parseWithNlohmann(text, fields);
+  }
+#endif
+#else
+  return parseWithNlohmann(text, fields);
+#endif
+}
+
+} // namespace mediasoupclient
@@ -0,0 +1,20 @@
+#ifndef JSON_PARSE_H_
+#define JSON_PARSE_H_
+
+#include <json.hpp>
+
+#include <initializer_list>
+#include <string_view>
+
+namespace mediasoupclient
+{
+
+// Parses a JSON document. When |fields| is not empty and the document is an object,
+// only those top-level members are materialized.
+// Built with MSC_USE_SIMDJSON, documents are parsed by simdjson, and by nlohmann::json when simdjson fails.
+// Free of JNI, so that it also builds in the host benchmarks.
+nlohmann::json parseJson(std::string_view text, std::initializer_list<const char*> fields = {});
+
+} // namespace mediasoupclient
+
+#endif // JSON_PARSE_H_
@@ -0,0 +1,88 @@
+#define MSC_CLASS "json_parser"
+
+#include "json_parser.h"
+
+#include <sdk/android/native_api/jni/java_types.h>
+
+#include <Logger.hpp>
+#include <new>
+#include <string>
+
+using namespace webrtc;
+
+namespace mediasoupclient
+{
+
+namespace
+{
+
+// Same conversion as String.getBytes(UTF_8), without going through the JVM.
+// |out| must have room for 3 bytes per char, so that nothing is allocated while the chars are pinned.
+void appendUtf8(std::string& out, const jchar* chars, jsize length)
+{
+  for (jsize i = 0; i < length; ++i)
+  {
+    uint32_t c = chars[i];
+    if (c >= 0xD800 && c <= 0xDFFF)
+    {
+      if (c <= 0xDBFF && i + 1 < length && chars[i + 1] >= 0xDC00 && chars[i + 1] <= 0xDFFF)
+      {
+        c = 0x10000 + ((c - 0xD800) << 10) + (chars[++i] - 0xDC00);
+      }
+      else
+      {
+        // Unpaired surrogate.
+        out.push_back('?');
+        continue;
+      }
+    }
+
+    if (c < 0x80)
+    {
+      out.push_back(static_cast<char>(c));
+    }
+    else if (c < 0x800)
+    {
+      out.push_back(static_cast<char>(0xC0 | (c >> 6)));
+      out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+    }
+    else if (c < 0x10000)
+    {
+      out.push_back(static_cast<char>(0xE0 | (c >> 12)));
+      out.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+    }
+    else
+    {
+      out.push_back(static_cast<char>(0xF0 | (c >> 18)));
+      out.push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+    }
+  }
+}
+
+} // namespace
+
+json JavaToNativeJson(JNIEnv* env, const JavaRef<jstring>& j_text, std::initializer_list<const char*> fields)
+{
+  auto length = env->GetStringLength(j_text.obj());
+  std::string text;
+  text.reserve(static_cast<size_t>(length) * 3);
+  auto* chars = env->GetStringCritical(j_text.obj(), nullptr);
+  if (chars == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  appendUtf8(text, chars, length);
+  env->ReleaseStringCritical(j_text.obj(), chars);
+
+  return parseJson(text, fields);
+}
+
+ScopedJavaLocalRef<jstring> NativeToJavaJson(JNIEnv* env, const json& value)
+{
+  return NativeToJavaString(env, value.dump());
+}
+
+} // namespace mediasoupclient
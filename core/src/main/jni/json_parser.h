@@ -0,0 +1,24 @@
+#ifndef JSON_PARSER_H_
+#define JSON_PARSER_H_
+
+#include <jni.h>
+#include <sdk/android/native_api/jni/scoped_java_ref.h>
+
+#include <initializer_list>
+#include <string_view>
+
+#include "jni_common.h"
+#include "json_parse.h"
+
+namespace mediasoupclient
+{
+
+// Converts the Java string to UTF-8 and parses it.
+json JavaToNativeJson(JNIEnv* env, const webrtc::JavaRef<jstring>& j_text, std::initializer_list<const char*> fields = {});
+
+// Serializes and creates a Java string from it.
+webrtc::ScopedJavaLocalRef<jstring> NativeToJavaJson(JNIEnv* env, const json& value);
+
+} // namespace mediasoupclient
+
+#endif // JSON_PARSER_H_
@@ -43,6 +43,8 @@ extern "C"
   {
     MSC_TRACE();
 
+    init(env);
+
     auto* handler = new LogHandlerInterfaceJNI(env, JavaParamRef<jobject>(env, j_handler));
     Logger::SetHandler(reinterpret_cast<Logger::LogHandlerInterface*>(handler));
     return NativeToJavaPointer(handler);
@@ -16,7 +16,7 @@ extern "C"
 
   JNI_DEFINE_METHOD(void, Logger, nativeSetLogLevel, jint j_level);
 
-  JNI_DEFINE_METHOD(void, Consumer, nativeDispose, jlong j_handler);
+  JNI_DEFINE_METHOD(void, Logger, nativeDispose, jlong j_handler);
 }
 
 } // namespace mediasoupclient
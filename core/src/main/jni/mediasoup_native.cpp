@@ -0,0 +1,142 @@
+#define MSC_CLASS "mediasoup_native"
+
+#include "mediasoup_native.h"
+
+#include <api/data_channel_interface.h>
+
+#include <Logger.hpp>
+#include <exception>
+
+#include "data_consumer.h"
+#include "data_producer.h"
+#ifndef MSC_DATA_ONLY
+#include "audio_sink.h"
+#include "video_thumbnail_sink.h"
+#endif
+
+using namespace mediasoupclient;
+
+int mediasoup_data_consumer_set_listener(int64_t data_consumer, const mediasoup_data_consumer_listener* listener)
+{
+  MSC_TRACE();
+
+  if (data_consumer == 0 || (listener != nullptr && listener->on_message == nullptr))
+  {
+    return MEDIASOUP_NATIVE_INVALID_ARGUMENT;
+  }
+
+  reinterpret_cast<OwnedDataConsumer*>(data_consumer)->listener()->SetNativeListener(listener);
+  return MEDIASOUP_NATIVE_OK;
+}
+
+int mediasoup_data_producer_send(int64_t data_producer, const uint8_t* data, size_t size, int binary)
+{
+  MSC_TRACE();
+
+  if (data_producer == 0 || (data == nullptr && size != 0))
+  {
+    return MEDIASOUP_NATIVE_INVALID_ARGUMENT;
+  }
+
+  try
+  {
+    auto* dataProducer = reinterpret_cast<OwnedDataProducer*>(data_producer)->dataProducer();
+    dataProducer->Send(webrtc::DataBuffer(rtc::CopyOnWriteBuffer(data, size), binary != 0));
+    return MEDIASOUP_NATIVE_OK;
+  }
+  catch (const std::exception& e)
+  {
+    MSC_WARN("send failed: %s", e.what());
+    return MEDIASOUP_NATIVE_FAILED;
+  }
+}
+
+int64_t mediasoup_data_producer_buffered_amount(int64_t data_producer)
+{
+  MSC_TRACE();
+
+  if (data_producer == 0)
+  {
+    return MEDIASOUP_NATIVE_INVALID_ARGUMENT;
+  }
+
+  try
+  {
+    return static_cast<int64_t>(reinterpret_cast<OwnedDataProducer*>(data_producer)->dataProducer()->GetBufferedAmount());
+  }
+  catch (const std::exception& e)
+  {
+    MSC_WARN("getting buffered amount failed: %s", e.what());
+    return MEDIASOUP_NATIVE_FAILED;
+  }
+}
+
+#ifndef MSC_DATA_ONLY
+size_t mediasoup_audio_sink_frame_samples(int64_t audio_sink)
+{
+  MSC_TRACE();
+
+  if (audio_sink == 0)
+  {
+    return 0;
+  }
+
+  return reinterpret_cast<AudioSink*>(audio_sink)->ring().frameSamples();
+}
+
+int64_t mediasoup_audio_sink_read(int64_t audio_sink, int16_t* dst, size_t max_frames)
+{
+  MSC_TRACE();
+
+  if (audio_sink == 0 || (dst == nullptr && max_frames != 0))
+  {
+    return MEDIASOUP_NATIVE_INVALID_ARGUMENT;
+  }
+
+  return static_cast<int64_t>(reinterpret_cast<AudioSink*>(audio_sink)->ring().pop(dst, max_frames));
+}
+
+int mediasoup_video_thumbnail_sink_poll(int64_t thumbnail_sink, mediasoup_i420_frame* frame)
+{
+  MSC_TRACE();
+
+  if (thumbnail_sink == 0 || frame == nullptr)
+  {
+    return MEDIASOUP_NATIVE_INVALID_ARGUMENT;
+  }
+
+  auto thumbnail = reinterpret_cast<VideoThumbnailSink*>(thumbnail_sink)->poll();
+  if (!thumbnail)
+  {
+    return 0;
+  }
+
+  auto buffer = thumbnail->video_frame_buffer();
+  const auto* i420 = buffer->GetI420();
+  frame->data_y = i420->DataY();
+  frame->data_u = i420->DataU();
+  frame->data_v = i420->DataV();
+  frame->stride_y = i420->StrideY();
+  frame->stride_u = i420->StrideU();
+  frame->stride_v = i420->StrideV();
+  frame->width = i420->width();
+  frame->height = i420->height();
+  frame->rotation = static_cast<int>(thumbnail->rotation());
+  frame->timestamp_us = thumbnail->timestamp_us();
+  frame->buffer = buffer.release();
+  return 1;
+}
+
+void mediasoup_i420_frame_release(mediasoup_i420_frame* frame)
+{
+  MSC_TRACE();
+
+  if (frame == nullptr || frame->buffer == nullptr)
+  {
+    return;
+  }
+
+  static_cast<webrtc::VideoFrameBuffer*>(frame->buffer)->Release();
+  frame->buffer = nullptr;
+}
+#endif
@@ -0,0 +1,191 @@
+#define MSC_CLASS "negotiation_scope"
+
+#include "negotiation_scope.h"
+
+#include <Logger.hpp>
+
+#ifdef MSC_ALLOC_STATS
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#endif
+
+#include "device_usage.h"
+#ifdef MSC_NEGOTIATION_STATS
+#include "negotiation_stats.h"
+#endif
+
+namespace mediasoupclient
+{
+
+namespace
+{
+
+#ifdef MSC_ALLOC_STATS
+thread_local size_t heapAllocations = 0;
+
+void* countedAllocate(size_t size) noexcept
+{
+  ++heapAllocations;
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void* countedAllocate(size_t size, std::align_val_t alignment) noexcept
+{
+  ++heapAllocations;
+  void* p = nullptr;
+  // posix_memalign() rather than aligned_alloc(), which bionic only has from API 28.
+  if (posix_memalign(&p, std::max(static_cast<size_t>(alignment), sizeof(void*)), size == 0 ? 1 : size) != 0)
+  {
+    return nullptr;
+  }
+  return p;
+}
+#endif
+
+} // namespace
+
+NegotiationScope::NegotiationScope(const char* name, DeviceUsage* usage)
+  : name_(name), usage_(usage), heapAllocations_(threadHeapAllocations()), start_(std::chrono::steady_clock::now())
+{
+}
+
+NegotiationScope::~NegotiationScope()
+{
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count();
+  [[maybe_unused]] auto heap = threadHeapAllocations() - heapAllocations_;
+#ifdef MSC_NEGOTIATION_STATS
+  recordNegotiation(name_, elapsed, heap);
+#endif
+  if (usage_ != nullptr)
+  {
+    usage_->addNegotiation(elapsed);
+  }
+
+#ifdef MSC_ALLOC_STATS
+  MSC_DEBUG("%s: %lldus, heap allocations:%zu", name_, static_cast<long long>(elapsed / 1000), heap);
+#endif
+}
+
+size_t threadHeapAllocations()
+{
+#ifdef MSC_ALLOC_STATS
+  return heapAllocations;
+#else
+  return 0;
+#endif
+}
+
+} // namespace mediasoupclient
+
+#ifdef MSC_ALLOC_STATS
+// Count every heap allocation made inside this library.
+// The whole family is replaced, so that no allocation reaches the default operators with memory from malloc() or the other way around.
+void* operator new(size_t size)
+{
+  if (void* p = mediasoupclient::countedAllocate(size))
+  {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+  return ::operator new(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+  if (void* p = mediasoupclient::countedAllocate(size, alignment))
+  {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+  return ::operator new(size, alignment);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+  return mediasoupclient::countedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+  return mediasoupclient::countedAllocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  return mediasoupclient::countedAllocate(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  return mediasoupclient::countedAllocate(size, alignment);
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, size_t, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p, size_t, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+  std::free(p);
+}
+#endif
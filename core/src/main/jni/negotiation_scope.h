@@ -0,0 +1,37 @@
+#ifndef NEGOTIATION_SCOPE_H_
+#define NEGOTIATION_SCOPE_H_
+
+#include <chrono>
+#include <cstddef>
+
+namespace mediasoupclient
+{
+
+class DeviceUsage;
+
+// Times a single JNI call that negotiates.
+// The duration of the scope is added to |usage| when given, and with MSC_NEGOTIATION_STATS
+// also the duration and heap allocation count to the NegotiationStats under |name|.
+class NegotiationScope final
+{
+public:
+  explicit NegotiationScope(const char* name, DeviceUsage* usage = nullptr);
+  ~NegotiationScope();
+
+  NegotiationScope(const NegotiationScope&) = delete;
+  NegotiationScope& operator=(const NegotiationScope&) = delete;
+
+private:
+  const char* name_;
+  DeviceUsage* usage_;
+  size_t heapAllocations_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+// Number of heap allocations made by the current thread.
+// Always 0 unless built with MSC_ALLOC_STATS.
+size_t threadHeapAllocations();
+
+} // namespace mediasoupclient
+
+#endif // NEGOTIATION_SCOPE_H_
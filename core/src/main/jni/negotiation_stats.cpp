@@ -0,0 +1,112 @@
+#define MSC_CLASS "negotiation_stats"
+
+#include "negotiation_stats.h"
+
+#include <sdk/android/native_api/jni/java_types.h>
+
+#include <Logger.hpp>
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "json_parser.h"
+
+using namespace webrtc;
+
+namespace mediasoupclient
+{
+
+#ifdef MSC_NEGOTIATION_STATS
+namespace
+{
+
+struct OperationStats
+{
+  uint64_t count{ 0 };
+  int64_t totalNanos{ 0 };
+  int64_t maxNanos{ 0 };
+  uint64_t heapAllocations{ 0 };
+  uint64_t maxHeapAllocations{ 0 };
+};
+
+std::mutex statsMutex;
+std::map<std::string, OperationStats, std::less<>> statsByOperation;
+
+} // namespace
+
+void recordNegotiation(const char* name, int64_t elapsedNanos, size_t heapAllocations)
+{
+  std::lock_guard<std::mutex> lock(statsMutex);
+
+  auto it = statsByOperation.find(std::string_view(name));
+  if (it == statsByOperation.end())
+  {
+    it = statsByOperation.emplace(name, OperationStats()).first;
+  }
+  auto& stats = it->second;
+  stats.count++;
+  stats.totalNanos += elapsedNanos;
+  stats.maxNanos = std::max(stats.maxNanos, elapsedNanos);
+  stats.heapAllocations += heapAllocations;
+  stats.maxHeapAllocations = std::max<uint64_t>(stats.maxHeapAllocations, heapAllocations);
+}
+
+json negotiationStats()
+{
+  std::lock_guard<std::mutex> lock(statsMutex);
+
+  auto result = json::object();
+  for (const auto& [name, stats] : statsByOperation)
+  {
+    result[name] = {
+      { "count", stats.count },
+      { "totalMicros", stats.totalNanos / 1000 },
+      { "meanMicros", stats.totalNanos / 1000 / static_cast<int64_t>(stats.count) },
+      { "maxMicros", stats.maxNanos / 1000 },
+      { "heapAllocations", stats.heapAllocations },
+      { "maxHeapAllocations", stats.maxHeapAllocations },
+    };
+  }
+  return result;
+}
+
+void resetNegotiationStats()
+{
+  std::lock_guard<std::mutex> lock(statsMutex);
+
+  statsByOperation.clear();
+}
+#else
+json negotiationStats()
+{
+  return json::object();
+}
+
+void resetNegotiationStats() {}
+#endif
+
+extern "C"
+{
+
+  JNI_DEFINE_METHOD(jstring, NegotiationStats, nativeGetStats)
+  {
+    MSC_TRACE();
+
+    return handleNativeCrash(env,
+                             [&]() {
+                               auto result = negotiationStats();
+                               return NativeToJavaJson(env, result).Release();
+                             })
+      .value_or(nullptr);
+  }
+
+  JNI_DEFINE_METHOD(void, NegotiationStats, nativeReset)
+  {
+    MSC_TRACE();
+
+    handleNativeCrashNoReturn(env, [&]() { resetNegotiationStats(); });
+  }
+}
+
+} // namespace mediasoupclient
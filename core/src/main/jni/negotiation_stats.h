@@ -0,0 +1,36 @@
+#ifndef NEGOTIATION_STATS_H_
+#define NEGOTIATION_STATS_H_
+
+#include <jni.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "jni_common.h"
+#include "jni_util.h"
+
+namespace mediasoupclient
+{
+
+#ifdef MSC_NEGOTIATION_STATS
+// Adds one completed run of the operation |name| to the process wide statistics.
+void recordNegotiation(const char* name, int64_t elapsedNanos, size_t heapAllocations);
+#endif
+
+// Per operation statistics, keyed by operation name.
+// Always empty unless built with MSC_NEGOTIATION_STATS.
+json negotiationStats();
+
+void resetNegotiationStats();
+
+extern "C"
+{
+
+  JNI_DEFINE_METHOD(jstring, NegotiationStats, nativeGetStats);
+
+  JNI_DEFINE_METHOD(void, NegotiationStats, nativeReset);
+}
+
+} // namespace mediasoupclient
+
+#endif // NEGOTIATION_STATS_H_
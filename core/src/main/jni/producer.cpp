@@ -4,8 +4,14 @@
 
 #include <sdk/android/native_api/jni/java_types.h>
 #include <sdk/android/native_api/jni/scoped_java_ref.h>
+#include <sdk/android/src/jni/pc/rtp_parameters.h>
 
 #include <Logger.hpp>
+#include <stdexcept>
+
+#include "json_parser.h"
+#include "simulcast_controller.h"
+#include "transport_lock.h"
 #include <Producer.hpp>
 
 using namespace webrtc;
@@ -18,6 +24,16 @@ extern jmethodID producerConstructorMethod;
 
 extern jmethodID producerListenerOnTransportCloseMethod;
 
+namespace
+{
+
+std::recursive_mutex &transportMutexOf(jlong j_producer)
+{
+  return *reinterpret_cast<OwnedProducer *>(j_producer)->transportMutex();
+}
+
+} // namespace
+
 extern "C"
 {
 
@@ -100,7 +116,7 @@ extern "C"
     return handleNativeCrash(env,
                              [&]() {
                                auto result = getProducer(j_producer)->GetRtpParameters();
-                               return NativeToJavaString(env, result.dump()).Release();
+                               return NativeToJavaJson(env, result).Release();
                              })
       .value_or(nullptr);
   }
@@ -135,8 +151,12 @@ extern "C"
 
     return handleNativeCrash(env,
                              [&]() {
+                               if (const auto &appData = reinterpret_cast<OwnedProducer *>(j_producer)->appData(); appData.opaque())
+                               {
+                                 return appData.toJava(env).Release();
+                               }
                                auto result = getProducer(j_producer)->GetAppData();
-                               return NativeToJavaString(env, result.dump()).Release();
+                               return NativeToJavaJson(env, result).Release();
                              })
       .value_or(nullptr);
   }
@@ -145,7 +165,10 @@ extern "C"
   {
     MSC_TRACE();
 
-    handleNativeCrashNoReturn(env, [&]() { getProducer(j_producer)->Close(); });
+    handleNativeCrashNoReturn(env, [&]() {
+      TransportLock lock(transportMutexOf(j_producer));
+      getProducer(j_producer)->Close();
+    });
   }
 
   JNI_DEFINE_METHOD(jstring, Producer, nativeGetStats, jlong j_producer)
@@ -154,8 +177,9 @@ extern "C"
 
     return handleNativeCrash(env,
                              [&]() {
+                               TransportLock lock(transportMutexOf(j_producer));
                                auto result = getProducer(j_producer)->GetStats();
-                               return NativeToJavaString(env, result.dump()).Release();
+                               return NativeToJavaJson(env, result).Release();
                              })
       .value_or(nullptr);
   }
@@ -164,14 +188,20 @@ extern "C"
   {
     MSC_TRACE();
 
-    handleNativeCrashNoReturn(env, [&]() { getProducer(j_producer)->Pause(); });
+    handleNativeCrashNoReturn(env, [&]() {
+      TransportLock lock(transportMutexOf(j_producer));
+      getProducer(j_producer)->Pause();
+    });
   }
 
   JNI_DEFINE_METHOD(void, Producer, nativeResume, jlong j_producer)
   {
     MSC_TRACE();
 
-    handleNativeCrashNoReturn(env, [&]() { getProducer(j_producer)->Resume(); });
+    handleNativeCrashNoReturn(env, [&]() {
+      TransportLock lock(transportMutexOf(j_producer));
+      getProducer(j_producer)->Resume();
+    });
   }
 
   JNI_DEFINE_METHOD(void, Producer, nativeReplaceTrack, jlong j_producer, jlong j_track)
@@ -180,6 +210,7 @@ extern "C"
 
     handleNativeCrashNoReturn(env, [&]() {
       auto track = webrtc::scoped_refptr(reinterpret_cast<webrtc::MediaStreamTrackInterface *>(j_track));
+      TransportLock lock(transportMutexOf(j_producer));
       getProducer(j_producer)->ReplaceTrack(track);
     });
   }
@@ -188,7 +219,54 @@ extern "C"
   {
     MSC_TRACE();
 
-    handleNativeCrashNoReturn(env, [&]() { getProducer(j_producer)->SetMaxSpatialLayer(j_spatialLayer); });
+    handleNativeCrashNoReturn(env, [&]() {
+      TransportLock lock(transportMutexOf(j_producer));
+      getProducer(j_producer)->SetMaxSpatialLayer(j_spatialLayer);
+    });
+  }
+
+  JNI_DEFINE_METHOD(void, Producer, nativeSetEncodings, jlong j_producer, jobjectArray j_encodings)
+  {
+    MSC_TRACE();
+
+    handleNativeCrashNoReturn(env, [&]() {
+      auto encodings = JavaToNativeVector<RtpEncodingParameters>(env, JavaParamRef<jobjectArray>(env, j_encodings), &jni::JavaToNativeRtpEncodingParameters);
+      TransportLock lock(transportMutexOf(j_producer));
+      auto* sender = getProducer(j_producer)->GetRtpSender();
+      auto parameters = sender->GetParameters();
+      if (encodings.size() != parameters.encodings.size())
+      {
+        throw std::invalid_argument("encodings do not match the producer layers");
+      }
+
+      // Only the fields that can change without renegotiation are taken, all layers in a single SetParameters().
+      for (size_t i = 0; i < encodings.size(); ++i)
+      {
+        const auto& source = encodings[i];
+        auto& target = parameters.encodings[i];
+        if (!source.rid.empty() && source.rid != target.rid)
+        {
+          throw std::invalid_argument("encoding rid " + source.rid + " does not match " + target.rid);
+        }
+        target.max_bitrate_bps = source.max_bitrate_bps;
+        target.max_framerate = source.max_framerate;
+        target.scale_resolution_down_by = source.scale_resolution_down_by;
+        target.active = source.active;
+        target.network_priority = source.network_priority;
+      }
+
+      auto result = sender->SetParameters(parameters);
+      if (!result.ok())
+      {
+        throw std::runtime_error(std::string("setEncodings failed: ") + result.message());
+      }
+      auto *ownedProducer = reinterpret_cast<OwnedProducer *>(j_producer);
+      ownedProducer->updateEncodings(parameters.encodings);
+      if (auto controller = ownedProducer->simulcastController())
+      {
+        controller->updateEncodings(ownedProducer->rtpParameters());
+      }
+    });
   }
 
   JNI_DEFINE_METHOD(void, Producer, nativeDispose, jlong j_producer)
@@ -207,16 +285,39 @@ void ProducerListenerJni::OnTransportClose(Producer *)
   env->CallVoidMethod(j_listener_.obj(), producerListenerOnTransportCloseMethod, j_producer_.obj());
 }
 
+void OwnedProducer::updateEncodings(const std::vector<RtpEncodingParameters> &encodings)
+{
+  MSC_TRACE();
+
+  std::lock_guard<std::mutex> lock(rtpParametersMutex_);
+  // libmediasoupclient keeps the parameters given at produce time, so the typed copy is built now to hold the change.
+  if (!rtpParameters_)
+  {
+    rtpParameters_ = rtp::Parameters::fromJson(producer_->GetRtpParameters());
+  }
+  auto &typed = rtpParameters_->encodings;
+  for (size_t i = 0; i < encodings.size() && i < typed.size(); ++i)
+  {
+    const auto &source = encodings[i];
+    auto &target = typed[i];
+    target.maxBitrate = source.max_bitrate_bps ? std::optional<uint32_t>(*source.max_bitrate_bps) : std::nullopt;
+    target.maxFramerate = source.max_framerate;
+    target.scaleResolutionDownBy = source.scale_resolution_down_by;
+    target.active = source.active;
+  }
+}
+
 inline Producer *getProducer(jlong j_producer)
 {
   return reinterpret_cast<OwnedProducer *>(j_producer)->producer();
 }
 
-ScopedJavaLocalRef<jobject> NativeToJavaProducer(JNIEnv *env, Producer *producer, ProducerListenerJni *listener)
+ScopedJavaLocalRef<jobject> NativeToJavaProducer(JNIEnv *env, Producer *producer, ProducerListenerJni *listener, UsageToken usage, AppData appData,
+                                                 std::shared_ptr<std::recursive_mutex> transportMutex)
 {
   MSC_TRACE();
 
-  auto ownedProducer = new OwnedProducer(producer, listener);
+  auto ownedProducer = new OwnedProducer(producer, listener, std::move(usage), std::move(appData), std::move(transportMutex));
   auto j_producer = ScopedJavaLocalRef<jobject>(env, env->NewObject(producerClass, producerConstructorMethod, NativeToJavaPointer(ownedProducer)));
   listener->SetJProducer(env, j_producer);
   return j_producer;
@@ -5,9 +5,15 @@
 #include <sdk/android/native_api/jni/scoped_java_ref.h>
 
 #include <Producer.hpp>
+#include <memory>
+#include <mutex>
+#include <optional>
 
+#include "app_data.h"
+#include "device_usage.h"
 #include "jni_common.h"
 #include "jni_util.h"
+#include "rtp_parameters.h"
 
 namespace mediasoupclient
 {
@@ -47,6 +53,8 @@ extern "C"
 
   JNI_DEFINE_METHOD(void, Producer, nativeSetMaxSpatialLayer, jlong j_producer, jint spatialLayer);
 
+  JNI_DEFINE_METHOD(void, Producer, nativeSetEncodings, jlong j_producer, jobjectArray j_encodings);
+
   JNI_DEFINE_METHOD(void, Producer, nativeDispose, jlong j_producer);
 }
 
@@ -67,10 +75,15 @@ private:
   ScopedJavaGlobalRef<jobject> j_producer_;
 };
 
+class SimulcastController;
+
 class OwnedProducer
 {
 public:
-  OwnedProducer(Producer *producer, ProducerListenerJni *listener) : producer_(producer), listener_(listener) {}
+  OwnedProducer(Producer *producer, ProducerListenerJni *listener, UsageToken usage, AppData appData, std::shared_ptr<std::recursive_mutex> transportMutex)
+    : producer_(producer), listener_(listener), usage_(std::move(usage)), appData_(std::move(appData)), transportMutex_(std::move(transportMutex))
+  {
+  }
 
   ~OwnedProducer()
   {
@@ -79,15 +92,50 @@ public:
   }
 
   Producer *producer() const { return producer_; }
+  // Typed copy of the RTP parameters, built on first use as only the layer and bitrate readers need it.
+  rtp::Parameters rtpParameters() const
+  {
+    std::lock_guard<std::mutex> lock(rtpParametersMutex_);
+    if (!rtpParameters_)
+    {
+      rtpParameters_ = rtp::Parameters::fromJson(producer_->GetRtpParameters());
+    }
+    return *rtpParameters_;
+  }
+  // Takes the fields applied by setEncodings() into the typed copy.
+  void updateEncodings(const std::vector<webrtc::RtpEncodingParameters> &encodings);
+  const AppData &appData() const { return appData_; }
+  // Held around the operations of the producer, as around those of its transport.
+  const std::shared_ptr<std::recursive_mutex> &transportMutex() const { return transportMutex_; }
+
+  void setSimulcastController(std::weak_ptr<SimulcastController> controller)
+  {
+    std::lock_guard<std::mutex> lock(simulcastControllerMutex_);
+    simulcastController_ = std::move(controller);
+  }
+
+  std::shared_ptr<SimulcastController> simulcastController()
+  {
+    std::lock_guard<std::mutex> lock(simulcastControllerMutex_);
+    return simulcastController_.lock();
+  }
 
 private:
   Producer *producer_;
   ProducerListenerJni *listener_;
+  UsageToken usage_;
+  AppData appData_;
+  mutable std::mutex rtpParametersMutex_;
+  mutable std::optional<rtp::Parameters> rtpParameters_;
+  const std::shared_ptr<std::recursive_mutex> transportMutex_;
+  std::mutex simulcastControllerMutex_;
+  std::weak_ptr<SimulcastController> simulcastController_;
 };
 
 inline Producer *getProducer(jlong j_producer);
 
-ScopedJavaLocalRef<jobject> NativeToJavaProducer(JNIEnv *env, Producer *producer, ProducerListenerJni *listener);
+ScopedJavaLocalRef<jobject> NativeToJavaProducer(JNIEnv *env, Producer *producer, ProducerListenerJni *listener, UsageToken usage, AppData appData,
+                                                 std::shared_ptr<std::recursive_mutex> transportMutex);
 
 } // namespace mediasoupclient
 
@@ -7,10 +7,17 @@
 
 #include <Logger.hpp>
 #include <Transport.hpp>
+#include <stdexcept>
 
+#ifndef MSC_DATA_ONLY
+#include "active_speaker_detector.h"
 #include "consumer.h"
+#endif
 #include "data_consumer.h"
 #include "jni_util.h"
+#include "json_parser.h"
+#include "negotiation_scope.h"
+#include "transport_lock.h"
 
 using namespace webrtc;
 
@@ -23,37 +30,127 @@ extern jmethodID recvTransportConstructorMethod;
 extern jmethodID transportListenerOnConnectMethod;
 extern jmethodID transportListenerOnConnectionStateChangeMethod;
 
+#ifndef MSC_DATA_ONLY
+namespace
+{
+
+// Shared by consume and swapConsumer.
+ScopedJavaLocalRef<jobject> consume(JNIEnv* env, jlong j_transport, jobject j_listener, jstring j_id, jstring j_producerId, jstring j_kind, jstring j_rtpParameters, jstring j_appData)
+{
+  auto* ownedTransport = getOwnedTransport(j_transport);
+  if (ownedTransport->dataOnly())
+  {
+    throw std::logic_error("cannot consume media with a data-only Device");
+  }
+  auto listener = new ConsumerListenerJni(env, JavaParamRef<jobject>(env, j_listener));
+  auto id = JavaToNativeString(env, JavaParamRef<jstring>(env, j_id));
+  auto producerId = JavaToNativeString(env, JavaParamRef<jstring>(env, j_producerId));
+  auto kind = JavaToNativeString(env, JavaParamRef<jstring>(env, j_kind));
+  auto rtpParameters = json::object();
+  if (j_rtpParameters != nullptr)
+  {
+    rtpParameters = JavaToNativeJson(env, JavaParamRef<jstring>(env, j_rtpParameters));
+  }
+  AppData keptAppData(env, j_appData, ownedTransport->appData().opaque());
+  auto appData = json::object();
+  if (j_appData != nullptr && !keptAppData.opaque())
+  {
+    appData = JavaToNativeJson(env, JavaParamRef<jstring>(env, j_appData));
+  }
+
+  TransportLock lock(*ownedTransport->mutex());
+  SdpWriteScope sdpWrite(*ownedTransport);
+  auto consumer = getRecvTransport(j_transport)->Consume(listener, id, producerId, kind, &rtpParameters, appData);
+  if (kind == "audio")
+  {
+    static_cast<OwnedRecvTransport*>(ownedTransport)->addAudioConsumer(consumer->GetId(), scoped_refptr<RtpReceiverInterface>(consumer->GetRtpReceiver()));
+  }
+  return NativeToJavaConsumer(env, consumer, listener, UsageToken(ownedTransport->usage(), DeviceUsage::kConsumers), std::move(keptAppData),
+                              ownedTransport->mutex());
+}
+
+} // namespace
+#endif
+
 extern "C"
 {
+#ifndef MSC_DATA_ONLY
   JNI_DEFINE_METHOD(jobject, RecvTransport, nativeConsume, jlong j_transport, jobject j_listener, jstring j_id, jstring j_producerId, jstring j_kind, jstring j_rtpParameters, jstring j_appData)
   {
+    MSC_TRACE();
+
+    NegotiationScope scope("RecvTransport.consume", getOwnedTransport(j_transport)->usage().get());
+
+    return handleNativeCrash(env, [&]() { return consume(env, j_transport, j_listener, j_id, j_producerId, j_kind, j_rtpParameters, j_appData).Release(); }).value_or(nullptr);
+  }
+
+  JNI_DEFINE_METHOD(jobject, RecvTransport, nativeSwapConsumer, jlong j_transport, jlong j_consumer, jobject j_listener, jstring j_id, jstring j_producerId, jstring j_kind,
+                    jstring j_rtpParameters, jstring j_appData)
+  {
+    MSC_TRACE();
+
+    NegotiationScope scope("RecvTransport.swapConsumer", getOwnedTransport(j_transport)->usage().get());
+
     return handleNativeCrash(env,
                              [&]() {
-                               auto listener = new ConsumerListenerJni(env, JavaParamRef<jobject>(env, j_listener));
-                               auto id = JavaToNativeString(env, JavaParamRef<jstring>(env, j_id));
-                               auto producerId = JavaToNativeString(env, JavaParamRef<jstring>(env, j_producerId));
-                               auto kind = JavaToNativeString(env, JavaParamRef<jstring>(env, j_kind));
-                               auto rtpParameters = json::object();
-                               if (j_rtpParameters != nullptr)
-                               {
-                                 rtpParameters = json::parse(JavaToNativeString(env, JavaParamRef<jstring>(env, j_rtpParameters)));
-                               }
-                               auto appData = json::object();
-                               if (j_appData != nullptr)
+                               auto* ownedTransport = getOwnedTransport(j_transport);
+                               auto* ownedConsumer = reinterpret_cast<OwnedConsumer*>(j_consumer);
+                               if (ownedConsumer->transportMutex() != ownedTransport->mutex())
                                {
-                                 appData = json::parse(JavaToNativeString(env, JavaParamRef<jstring>(env, j_appData)));
+                                 throw std::invalid_argument("consumer does not belong to this transport");
                                }
 
-                               auto consumer = getRecvTransport(j_transport)->Consume(listener, id, producerId, kind, &rtpParameters, appData);
-                               return NativeToJavaConsumer(env, consumer, listener).Release();
+                               // Two SDP exchanges: the m-section may only be recycled once a completed negotiation has rejected it,
+                               // so Close() renegotiates on its own before Consume() takes the section over.
+                               TransportLock lock(*ownedTransport->mutex());
+                               SdpWriteScope sdpWrite(*ownedTransport);
+                               ownedConsumer->consumer()->Close();
+                               return consume(env, j_transport, j_listener, j_id, j_producerId, j_kind, j_rtpParameters, j_appData).Release();
                              })
       .value_or(nullptr);
   }
+#else
+  // Registered in the data-only build too, so that the media entry points throw MediasoupException rather than UnsatisfiedLinkError.
+  JNI_DEFINE_METHOD(jobject, RecvTransport, nativeConsume, jlong, jobject, jstring, jstring, jstring, jstring, jstring)
+  {
+    MSC_TRACE();
+
+    throwMediasoupException(env, "consume is not available in the data-only build");
+    return nullptr;
+  }
+
+  JNI_DEFINE_METHOD(jobject, RecvTransport, nativeSwapConsumer, jlong, jlong, jobject, jstring, jstring, jstring, jstring, jstring)
+  {
+    MSC_TRACE();
+
+    throwMediasoupException(env, "swapConsumer is not available in the data-only build");
+    return nullptr;
+  }
+
+  JNI_DEFINE_METHOD(jlong, RecvTransport, nativeCreateActiveSpeakerDetector, jlong, jobject, jint, jdouble, jint, jint, jint)
+  {
+    MSC_TRACE();
+
+    throwMediasoupException(env, "createActiveSpeakerDetector is not available in the data-only build");
+    return 0L;
+  }
+
+  JNI_DEFINE_METHOD(jlong, RecvTransport, nativeCreateVisibilityScheduler, jlong, jobject, jint, jintArray)
+  {
+    MSC_TRACE();
+
+    throwMediasoupException(env, "createVisibilityScheduler is not available in the data-only build");
+    return 0L;
+  }
+#endif
 
   JNI_DEFINE_METHOD(jobject, RecvTransport, nativeConsumeData, jlong j_transport, jobject j_listener, jstring j_id, jstring j_producerId, jint j_stream_id, jstring j_label, jstring j_protocol, jstring j_appData)
   {
     MSC_TRACE();
 
+    auto* ownedTransport = getOwnedTransport(j_transport);
+    NegotiationScope scope("RecvTransport.consumeData", ownedTransport->usage().get());
+
     return handleNativeCrash(env,
                              [&]() {
                                auto listener = new DataConsumerListenerJni(env, JavaParamRef<jobject>(env, j_listener));
@@ -62,14 +159,19 @@ extern "C"
                                auto streamId = static_cast<uint16_t>(j_stream_id);
                                auto label = JavaToNativeString(env, JavaParamRef<jstring>(env, j_label));
                                auto protocol = JavaToNativeString(env, JavaParamRef<jstring>(env, j_protocol));
+                               AppData keptAppData(env, j_appData, ownedTransport->appData().opaque());
                                auto appData = json::object();
-                               if (j_appData != nullptr)
+                               if (j_appData != nullptr && !keptAppData.opaque())
                                {
-                                 appData = json::parse(JavaToNativeString(env, JavaParamRef<jstring>(env, j_appData)));
+                                 appData = JavaToNativeJson(env, JavaParamRef<jstring>(env, j_appData));
                                }
 
+                               TransportLock lock(*ownedTransport->mutex());
+                               SdpWriteScope sdpWrite(*ownedTransport);
                                auto dataConsumer = getRecvTransport(j_transport)->ConsumeData(listener, id, producerId, streamId, label, protocol, appData);
-                               return NativeToJavaDataConsumer(env, dataConsumer, listener).Release();
+                               return NativeToJavaDataConsumer(env, dataConsumer, listener, UsageToken(ownedTransport->usage(), DeviceUsage::kDataConsumers), std::move(keptAppData),
+                                                               ownedTransport->mutex())
+                                 .Release();
                              })
       .value_or(nullptr);
   }
@@ -79,11 +181,13 @@ std::future<void> RecvTransportListenerJni::OnConnect(Transport*, const json& dt
 {
   MSC_TRACE();
 
+  // Waited for with the transport locked, see SendTransportListenerJni::OnConnect.
   return std::async(
     std::launch::async,
     [](const jobject& j_listener, const jobject& j_transport, const json& dtlsParameters) {
       JNIEnv* env = webrtc::AttachCurrentThreadIfNeeded();
-      env->CallVoidMethod(j_listener, transportListenerOnConnectMethod, j_transport, NativeToJavaString(env, dtlsParameters.dump()).obj());
+      NegotiationScope scope("RecvTransport.onConnect");
+      env->CallVoidMethod(j_listener, transportListenerOnConnectMethod, j_transport, NativeToJavaJson(env, dtlsParameters).obj());
     },
     j_listener_.obj(), j_transport_.obj(), dtlsParameters);
 }
@@ -101,11 +205,11 @@ inline RecvTransport* getRecvTransport(jlong j_transport)
   return reinterpret_cast<OwnedRecvTransport*>(j_transport)->recvTransport();
 }
 
-ScopedJavaLocalRef<jobject> NativeToJavaRecvTransport(JNIEnv* env, RecvTransport* transport, RecvTransportListenerJni* listener)
+ScopedJavaLocalRef<jobject> NativeToJavaRecvTransport(JNIEnv* env, RecvTransport* transport, RecvTransportListenerJni* listener, UsageToken usage, AppData appData, bool dataOnly)
 {
   MSC_TRACE();
 
-  auto ownedTransport = new OwnedRecvTransport(transport, listener);
+  auto ownedTransport = new OwnedRecvTransport(transport, listener, std::move(usage), std::move(appData), dataOnly);
   auto j_transport = ScopedJavaLocalRef<jobject>(env, env->NewObject(recvTransportClass, recvTransportConstructorMethod, NativeToJavaPointer(ownedTransport)));
   listener->SetJTransport(env, j_transport);
   return j_transport;
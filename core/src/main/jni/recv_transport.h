@@ -4,7 +4,13 @@
 #include <jni.h>
 #include <sdk/android/native_api/jni/scoped_java_ref.h>
 
+#include <api/rtp_receiver_interface.h>
+
 #include <Transport.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
 
 #include "jni_common.h"
 #include "jni_util.h"
@@ -18,11 +24,18 @@ namespace mediasoupclient
 extern "C"
 {
   JNI_DEFINE_METHOD(jobject, RecvTransport, nativeConsume, jlong j_transport, jobject j_listener, jstring j_id, jstring j_producerId, jstring j_kind, jstring j_rtpParameters, jstring j_appData);
+  JNI_DEFINE_METHOD(jobject, RecvTransport, nativeSwapConsumer, jlong j_transport, jlong j_consumer, jobject j_listener, jstring j_id, jstring j_producerId, jstring j_kind,
+                    jstring j_rtpParameters, jstring j_appData);
+  JNI_DEFINE_METHOD(jlong, RecvTransport, nativeCreateActiveSpeakerDetector, jlong j_transport, jobject j_listener, jint j_intervalMs, jdouble j_smoothing, jint j_thresholdDbov,
+                    jint j_marginDb, jint j_switchDelayMs);
+  JNI_DEFINE_METHOD(jlong, RecvTransport, nativeCreateVisibilityScheduler, jlong j_transport, jobject j_listener, jint j_debounceMs, jintArray j_layerHeights);
   JNI_DEFINE_METHOD(jobject, RecvTransport, nativeConsumeData, jlong j_transport, jobject j_listener, jstring j_id, jstring j_producerId, jint j_stream_id, jstring j_label, jstring j_protocol, jstring j_appData);
 }
 
 extern jclass transportListenerClass;
 
+class ActiveSpeakerDetector;
+
 class RecvTransportListenerJni final : public RecvTransport::Listener
 {
 public:
@@ -45,7 +58,10 @@ private:
 class OwnedRecvTransport final : public OwnedTransport
 {
 public:
-  OwnedRecvTransport(RecvTransport* transport, RecvTransportListenerJni* listener) : transport_(transport), listener_(listener) {}
+  OwnedRecvTransport(RecvTransport* transport, RecvTransportListenerJni* listener, UsageToken usage, AppData appData, bool dataOnly)
+    : OwnedTransport(std::move(usage), std::move(appData), dataOnly), transport_(transport), listener_(listener)
+  {
+  }
 
   ~OwnedRecvTransport() override
   {
@@ -56,14 +72,33 @@ public:
   Transport* transport() const override { return transport_; }
   RecvTransport* recvTransport() const { return transport_; }
 
+  // |detector| gets the open audio consumers of the transport, and those created from now on.
+  void setSpeakerDetector(std::weak_ptr<ActiveSpeakerDetector> detector);
+
+  std::shared_ptr<ActiveSpeakerDetector> speakerDetector()
+  {
+    std::lock_guard<std::mutex> lock(speakerDetectorMutex_);
+    return speakerDetector_.lock();
+  }
+
+  // Tracked for the speaker detectors created later, and added to the current one.
+  void addAudioConsumer(const std::string& consumerId, scoped_refptr<RtpReceiverInterface> receiver);
+
 private:
+  // Drops the receivers of closed consumers.
+  void pruneAudioReceivers();
+
   RecvTransport* transport_;
   RecvTransportListenerJni* listener_;
+  // Guards the detector and the audio receivers.
+  std::mutex speakerDetectorMutex_;
+  std::weak_ptr<ActiveSpeakerDetector> speakerDetector_;
+  std::map<std::string, scoped_refptr<RtpReceiverInterface>> audioReceivers_;
 };
 
 inline RecvTransport* getRecvTransport(jlong j_transport);
 
-ScopedJavaLocalRef<jobject> NativeToJavaRecvTransport(JNIEnv* env, RecvTransport* transport, RecvTransportListenerJni* listener);
+ScopedJavaLocalRef<jobject> NativeToJavaRecvTransport(JNIEnv* env, RecvTransport* transport, RecvTransportListenerJni* listener, UsageToken usage, AppData appData, bool dataOnly);
 
 } // namespace mediasoupclient
 
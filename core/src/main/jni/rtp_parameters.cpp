@@ -0,0 +1,378 @@
+#define MSC_CLASS "rtp_parameters"
+
+#include "rtp_parameters.h"
+
+#include <Logger.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace mediasoupclient
+{
+namespace rtp
+{
+
+namespace
+{
+
+const json* member(const json& object, const char* key)
+{
+  auto it = object.find(key);
+  return it == object.end() || it->is_null() ? nullptr : &*it;
+}
+
+std::string stringOf(const json& object, const char* key)
+{
+  const auto* value = member(object, key);
+  return value && value->is_string() ? value->get<std::string>() : std::string();
+}
+
+// Integers out of the range of |T| throw instead of being truncated.
+template<typename T>
+std::optional<T> numberOf(const json& object, const char* key)
+{
+  const auto* value = member(object, key);
+  if (!value || !value->is_number())
+  {
+    return std::nullopt;
+  }
+  if constexpr (std::is_integral_v<T>)
+  {
+    auto number = value->get<double>();
+    if (number < static_cast<double>(std::numeric_limits<T>::min()) || number > static_cast<double>(std::numeric_limits<T>::max()) || number != std::floor(number))
+    {
+      throw std::out_of_range(std::string(key) + " out of range: " + value->dump());
+    }
+  }
+  return value->get<T>();
+}
+
+bool boolOf(const json& object, const char* key, bool defaultValue)
+{
+  const auto* value = member(object, key);
+  return value && value->is_boolean() ? value->get<bool>() : defaultValue;
+}
+
+json objectOf(const json& object, const char* key)
+{
+  const auto* value = member(object, key);
+  return value && value->is_object() ? *value : json::object();
+}
+
+// Calls |fn| on each object of the |key| array.
+template<typename Fn>
+void forEach(const json& object, const char* key, Fn fn)
+{
+  const auto* value = member(object, key);
+  if (!value || !value->is_array())
+  {
+    return;
+  }
+  for (const auto& item : *value)
+  {
+    if (item.is_object())
+    {
+      fn(item);
+    }
+  }
+}
+
+std::vector<RtcpFeedback> rtcpFeedbackOf(const json& object)
+{
+  std::vector<RtcpFeedback> result;
+  forEach(object, "rtcpFeedback", [&result](const json& item) { result.push_back({ stringOf(item, "type"), stringOf(item, "parameter") }); });
+  return result;
+}
+
+json rtcpFeedbackToJson(const std::vector<RtcpFeedback>& rtcpFeedback)
+{
+  auto result = json::array();
+  for (const auto& fb : rtcpFeedback)
+  {
+    result.push_back({ { "type", fb.type }, { "parameter", fb.parameter } });
+  }
+  return result;
+}
+
+// Parses the layer counts out of "L<spatial>T<temporal>[_KEY[_SHIFT]]" or "S<spatial>T<temporal>[h]".
+void parseScalabilityMode(Encoding& encoding)
+{
+  const auto& mode = encoding.scalabilityMode;
+  if (mode.size() < 4 || (mode[0] != 'L' && mode[0] != 'S'))
+  {
+    return;
+  }
+  auto t = mode.find('T', 1);
+  if (t == std::string::npos || t == 1 || t + 1 >= mode.size() || !std::isdigit(static_cast<unsigned char>(mode[t + 1])))
+  {
+    return;
+  }
+  int spatial = 0;
+  for (size_t i = 1; i < t; ++i)
+  {
+    if (!std::isdigit(static_cast<unsigned char>(mode[i])))
+    {
+      return;
+    }
+    spatial = spatial * 10 + (mode[i] - '0');
+  }
+  int temporal = 0;
+  for (size_t i = t + 1; i < mode.size() && std::isdigit(static_cast<unsigned char>(mode[i])); ++i)
+  {
+    temporal = temporal * 10 + (mode[i] - '0');
+  }
+  if (spatial > 0 && temporal > 0)
+  {
+    encoding.spatialLayers = spatial;
+    encoding.temporalLayers = temporal;
+  }
+}
+
+bool equalsIgnoreCase(const std::string& a, const std::string& b)
+{
+  return a.size() == b.size() &&
+         std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) { return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y)); });
+}
+
+bool isRtxMimeType(const std::string& mimeType)
+{
+  auto slash = mimeType.find('/');
+  return slash != std::string::npos && equalsIgnoreCase(mimeType.substr(slash + 1), "rtx");
+}
+
+bool contains(const std::vector<std::string>& values, const std::string& value)
+{
+  return std::find(values.begin(), values.end(), value) != values.end();
+}
+
+} // namespace
+
+bool Codec::isRtx() const
+{
+  return isRtxMimeType(mimeType);
+}
+
+Parameters Parameters::fromJson(const json& value)
+{
+  MSC_TRACE();
+
+  Parameters result;
+  if (!value.is_object())
+  {
+    return result;
+  }
+
+  result.mid = stringOf(value, "mid");
+  forEach(value, "codecs", [&result](const json& item) {
+    auto& codec = result.codecs.emplace_back();
+    codec.mimeType = stringOf(item, "mimeType");
+    codec.payloadType = numberOf<uint8_t>(item, "payloadType").value_or(0);
+    codec.clockRate = numberOf<uint32_t>(item, "clockRate").value_or(0);
+    codec.channels = numberOf<uint8_t>(item, "channels");
+    codec.parameters = objectOf(item, "parameters");
+    codec.rtcpFeedback = rtcpFeedbackOf(item);
+  });
+  forEach(value, "headerExtensions", [&result](const json& item) {
+    result.headerExtensions.push_back({ stringOf(item, "uri"), numberOf<uint8_t>(item, "id").value_or(0), boolOf(item, "encrypt", false) });
+  });
+  forEach(value, "encodings", [&result](const json& item) {
+    auto& encoding = result.encodings.emplace_back();
+    encoding.ssrc = numberOf<uint32_t>(item, "ssrc");
+    if (const auto* rtx = member(item, "rtx"); rtx && rtx->is_object())
+    {
+      encoding.rtxSsrc = numberOf<uint32_t>(*rtx, "ssrc");
+    }
+    encoding.rid = stringOf(item, "rid");
+    encoding.codecPayloadType = numberOf<uint8_t>(item, "codecPayloadType");
+    encoding.maxBitrate = numberOf<uint32_t>(item, "maxBitrate");
+    encoding.maxFramerate = numberOf<double>(item, "maxFramerate");
+    encoding.scaleResolutionDownBy = numberOf<double>(item, "scaleResolutionDownBy");
+    encoding.dtx = boolOf(item, "dtx", false);
+    encoding.active = boolOf(item, "active", true);
+    encoding.scalabilityMode = stringOf(item, "scalabilityMode");
+    parseScalabilityMode(encoding);
+  });
+  if (const auto* rtcp = member(value, "rtcp"); rtcp && rtcp->is_object())
+  {
+    result.rtcp.cname = stringOf(*rtcp, "cname");
+    result.rtcp.reducedSize = boolOf(*rtcp, "reducedSize", true);
+  }
+  return result;
+}
+
+int Parameters::spatialLayers() const
+{
+  if (encodings.size() > 1)
+  {
+    return static_cast<int>(encodings.size());
+  }
+  return encodings.empty() ? 1 : encodings.front().spatialLayers;
+}
+
+json CodecCapability::toJson() const
+{
+  json result = {
+    { "kind", kind },
+    { "mimeType", mimeType },
+    { "clockRate", clockRate },
+    { "parameters", parameters },
+    { "rtcpFeedback", rtcpFeedbackToJson(rtcpFeedback) },
+  };
+  if (preferredPayloadType)
+  {
+    result["preferredPayloadType"] = *preferredPayloadType;
+  }
+  if (channels)
+  {
+    result["channels"] = *channels;
+  }
+  return result;
+}
+
+Capabilities Capabilities::fromJson(const json& value)
+{
+  MSC_TRACE();
+
+  Capabilities result;
+  if (!value.is_object())
+  {
+    return result;
+  }
+
+  forEach(value, "codecs", [&result](const json& item) {
+    auto& codec = result.codecs.emplace_back();
+    codec.kind = stringOf(item, "kind");
+    codec.mimeType = stringOf(item, "mimeType");
+    codec.preferredPayloadType = numberOf<uint8_t>(item, "preferredPayloadType");
+    codec.clockRate = numberOf<uint32_t>(item, "clockRate").value_or(0);
+    codec.channels = numberOf<uint8_t>(item, "channels");
+    codec.parameters = objectOf(item, "parameters");
+    codec.rtcpFeedback = rtcpFeedbackOf(item);
+  });
+  forEach(value, "headerExtensions", [&result](const json& item) {
+    result.headerExtensions.push_back(
+      { stringOf(item, "kind"), stringOf(item, "uri"), numberOf<uint8_t>(item, "preferredId").value_or(0), boolOf(item, "preferredEncrypt", false), stringOf(item, "direction") });
+  });
+  return result;
+}
+
+json Capabilities::toJson() const
+{
+  MSC_TRACE();
+
+  auto jsonCodecs = json::array();
+  for (const auto& codec : codecs)
+  {
+    jsonCodecs.push_back(codec.toJson());
+  }
+
+  auto jsonHeaderExtensions = json::array();
+  for (const auto& ext : headerExtensions)
+  {
+    json item = { { "kind", ext.kind }, { "uri", ext.uri }, { "preferredId", ext.preferredId }, { "preferredEncrypt", ext.preferredEncrypt } };
+    if (!ext.direction.empty())
+    {
+      item["direction"] = ext.direction;
+    }
+    jsonHeaderExtensions.push_back(std::move(item));
+  }
+
+  return { { "codecs", std::move(jsonCodecs) }, { "headerExtensions", std::move(jsonHeaderExtensions) } };
+}
+
+namespace
+{
+
+std::string toLower(std::string value)
+{
+  std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  return value;
+}
+
+} // namespace
+
+CapabilityIndex::CapabilityIndex(Capabilities capabilities) : capabilities_(std::move(capabilities))
+{
+  MSC_TRACE();
+
+  const auto& codecs = capabilities_.codecs;
+  for (size_t i = 0; i < codecs.size(); ++i)
+  {
+    const auto& codec = codecs[i];
+    hasAudio_ |= codec.kind == "audio";
+    hasVideo_ |= codec.kind == "video";
+    if (!isRtxMimeType(codec.mimeType))
+    {
+      byMimeType_.emplace(toLower(codec.mimeType), i);
+    }
+  }
+}
+
+bool CapabilityIndex::hasKind(const std::string& kind) const
+{
+  return kind == "audio" ? hasAudio_ : kind == "video" && hasVideo_;
+}
+
+const CodecCapability* CapabilityIndex::findCodec(const std::string& mimeType) const
+{
+  auto it = byMimeType_.find(toLower(mimeType));
+  return it == byMimeType_.end() ? nullptr : &capabilities_.codecs[it->second];
+}
+
+void CapabilityFilter::apply(Capabilities& capabilities) const
+{
+  MSC_TRACE();
+
+  auto& codecs = capabilities.codecs;
+  if (mimeTypes)
+  {
+    auto allowed = [this](const CodecCapability& codec) {
+      return std::any_of(mimeTypes->begin(), mimeTypes->end(), [&codec](const std::string& mimeType) { return equalsIgnoreCase(mimeType, codec.mimeType); });
+    };
+    std::vector<uint8_t> keptPayloadTypes;
+    for (const auto& codec : codecs)
+    {
+      if (!isRtxMimeType(codec.mimeType) && allowed(codec) && codec.preferredPayloadType)
+      {
+        keptPayloadTypes.push_back(*codec.preferredPayloadType);
+      }
+    }
+    auto removed = std::remove_if(codecs.begin(), codecs.end(), [&](const CodecCapability& codec) {
+      if (!isRtxMimeType(codec.mimeType))
+      {
+        return !allowed(codec);
+      }
+      auto apt = codec.parameters.find("apt");
+      return apt == codec.parameters.end() || !apt->is_number() || std::find(keptPayloadTypes.begin(), keptPayloadTypes.end(), apt->get<int>()) == keptPayloadTypes.end();
+    });
+    MSC_DEBUG("pruned %zu of %zu codecs", static_cast<size_t>(codecs.end() - removed), codecs.size());
+    codecs.erase(removed, codecs.end());
+  }
+
+  if (rtcpFeedback)
+  {
+    for (auto& codec : codecs)
+    {
+      auto& feedback = codec.rtcpFeedback;
+      feedback.erase(std::remove_if(feedback.begin(), feedback.end(),
+                                    [this](const RtcpFeedback& fb) {
+                                      return !contains(*rtcpFeedback, fb.type) && (fb.parameter.empty() || !contains(*rtcpFeedback, fb.type + " " + fb.parameter));
+                                    }),
+                     feedback.end());
+    }
+  }
+
+  if (headerExtensions)
+  {
+    auto& extensions = capabilities.headerExtensions;
+    auto removed = std::remove_if(extensions.begin(), extensions.end(), [this](const HeaderExtensionCapability& ext) { return !contains(*headerExtensions, ext.uri); });
+    MSC_DEBUG("pruned %zu of %zu header extensions", static_cast<size_t>(extensions.end() - removed), extensions.size());
+    extensions.erase(removed, extensions.end());
+  }
+}
+
+} // namespace rtp
+} // namespace mediasoupclient
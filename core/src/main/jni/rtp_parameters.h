@@ -0,0 +1,155 @@
+#ifndef RTP_PARAMETERS_H_
+#define RTP_PARAMETERS_H_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "jni_common.h"
+
+namespace mediasoupclient
+{
+
+// Typed copies of the mediasoup RTP parameters and capabilities, read by the bridge only:
+// the encodings of producers for the simulcast controller, the layers of consumers for the visibility scheduler,
+// and the capability filter and index of Device.load. produce and consume still pass json to libmediasoupclient,
+// which works on json throughout. Codec parameters stay json as their members depend on the codec.
+namespace rtp
+{
+
+struct RtcpFeedback
+{
+  std::string type;
+  std::string parameter;
+};
+
+struct Codec
+{
+  std::string mimeType;
+  uint8_t payloadType{ 0 };
+  uint32_t clockRate{ 0 };
+  std::optional<uint8_t> channels;
+  json parameters = json::object();
+  std::vector<RtcpFeedback> rtcpFeedback;
+
+  bool isRtx() const;
+};
+
+struct HeaderExtension
+{
+  std::string uri;
+  uint8_t id{ 0 };
+  bool encrypt{ false };
+};
+
+struct Encoding
+{
+  std::optional<uint32_t> ssrc;
+  std::optional<uint32_t> rtxSsrc;
+  std::string rid;
+  std::optional<uint8_t> codecPayloadType;
+  std::optional<uint32_t> maxBitrate;
+  std::optional<double> maxFramerate;
+  std::optional<double> scaleResolutionDownBy;
+  bool dtx{ false };
+  bool active{ true };
+  std::string scalabilityMode;
+  // From scalabilityMode ("L3T3", "S2T1_KEY", ...), 1 when absent.
+  int spatialLayers{ 1 };
+  int temporalLayers{ 1 };
+};
+
+struct Rtcp
+{
+  std::string cname;
+  bool reducedSize{ true };
+};
+
+struct Parameters
+{
+  std::string mid;
+  std::vector<Codec> codecs;
+  std::vector<HeaderExtension> headerExtensions;
+  std::vector<Encoding> encodings;
+  Rtcp rtcp;
+
+  // Throws std::out_of_range for numbers that do not fit their field.
+  static Parameters fromJson(const json& value);
+
+  // Simulcast streams, or the spatial layers of the single SVC stream.
+  int spatialLayers() const;
+};
+
+struct CodecCapability
+{
+  std::string kind;
+  std::string mimeType;
+  std::optional<uint8_t> preferredPayloadType;
+  uint32_t clockRate{ 0 };
+  std::optional<uint8_t> channels;
+  json parameters = json::object();
+  std::vector<RtcpFeedback> rtcpFeedback;
+
+  json toJson() const;
+};
+
+struct HeaderExtensionCapability
+{
+  std::string kind;
+  std::string uri;
+  uint8_t preferredId{ 0 };
+  bool preferredEncrypt{ false };
+  std::string direction;
+};
+
+struct Capabilities
+{
+  std::vector<CodecCapability> codecs;
+  std::vector<HeaderExtensionCapability> headerExtensions;
+
+  static Capabilities fromJson(const json& value);
+  json toJson() const;
+};
+
+// Mime type and kind lookups over the capabilities of a loaded Device, for Device.canProduce and Device.findCodec.
+// Only the bridge queries it; the ortc matching of libmediasoupclient in load, produce and consume still walks the json arrays.
+class CapabilityIndex final
+{
+public:
+  explicit CapabilityIndex(Capabilities capabilities);
+
+  const Capabilities& capabilities() const { return capabilities_; }
+
+  bool hasKind(const std::string& kind) const;
+  // First codec with |mimeType|, case-insensitive, RTX excluded.
+  const CodecCapability* findCodec(const std::string& mimeType) const;
+
+private:
+  const Capabilities capabilities_;
+  std::unordered_map<std::string, size_t> byMimeType_;
+  bool hasAudio_{ false };
+  bool hasVideo_{ false };
+};
+
+// Prunes router capabilities at Device load, so SDP offers and answers only carry what the app uses.
+// An absent list keeps everything of its kind, an empty one removes everything.
+struct CapabilityFilter
+{
+  // Codec mime types, case-insensitive. RTX is kept for the kept codecs.
+  std::optional<std::vector<std::string>> mimeTypes;
+  // Header extension URIs.
+  std::optional<std::vector<std::string>> headerExtensions;
+  // RTCP feedback, as "type" or "type parameter".
+  std::optional<std::vector<std::string>> rtcpFeedback;
+
+  bool empty() const { return !mimeTypes && !headerExtensions && !rtcpFeedback; }
+  void apply(Capabilities& capabilities) const;
+};
+
+} // namespace rtp
+
+} // namespace mediasoupclient
+
+#endif // RTP_PARAMETERS_H_
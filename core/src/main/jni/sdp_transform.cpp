@@ -0,0 +1,1419 @@
+// Handwritten replacement for libsdptransform's regex based parser.cpp and writer.cpp.
+// Produces the same objects as the sdptransform grammar. The less common attributes
+// that have no matcher here (imageattr, mediaclk, bfcp, ...) are kept as "invalid" entries, which are written back verbatim.
+
+#include "sdp_transform.h"
+
+#include <sdptransform.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace sdptransform
+{
+
+namespace
+{
+
+using Captures = std::array<std::optional<std::string_view>, 13>;
+
+class Cursor
+{
+public:
+  explicit Cursor(std::string_view text) : text_(text) {}
+
+  bool atEnd() const { return pos_ >= text_.size(); }
+  char peek() const { return atEnd() ? '\0' : text_[pos_]; }
+  size_t pos() const { return pos_; }
+  void seek(size_t pos) { pos_ = pos; }
+
+  bool literal(std::string_view value)
+  {
+    if (text_.compare(pos_, value.size(), value) != 0)
+    {
+      return false;
+    }
+    pos_ += value.size();
+    return true;
+  }
+
+  bool character(char c)
+  {
+    if (peek() != c || atEnd())
+    {
+      return false;
+    }
+    ++pos_;
+    return true;
+  }
+
+  template <typename Predicate>
+  std::string_view span(Predicate predicate)
+  {
+    auto start = pos_;
+    while (pos_ < text_.size() && predicate(text_[pos_]))
+    {
+      ++pos_;
+    }
+    return text_.substr(start, pos_ - start);
+  }
+
+  std::optional<std::string_view> oneOf(std::initializer_list<std::string_view> values)
+  {
+    for (auto value : values)
+    {
+      if (literal(value))
+      {
+        return value;
+      }
+    }
+    return std::nullopt;
+  }
+
+  std::string_view rest()
+  {
+    auto result = text_.substr(pos_);
+    pos_ = text_.size();
+    return result;
+  }
+
+private:
+  std::string_view text_;
+  size_t pos_{ 0 };
+};
+
+bool isDigit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+bool isWord(char c)
+{
+  return isDigit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+bool isSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+bool isNonSpace(char c)
+{
+  return !isSpace(c);
+}
+
+// \d*
+std::string_view digits(Cursor& cursor)
+{
+  return cursor.span(isDigit);
+}
+
+// \S*
+std::string_view nonSpace(Cursor& cursor)
+{
+  return cursor.span(isNonSpace);
+}
+
+// [\S| ]*
+std::string_view nonSpaceOrBlank(Cursor& cursor)
+{
+  return cursor.span([](char c) { return c == ' ' || !isSpace(c); });
+}
+
+// (?: (\S*))?
+std::optional<std::string_view> optionalToken(Cursor& cursor)
+{
+  if (!cursor.character(' '))
+  {
+    return std::nullopt;
+  }
+  return nonSpace(cursor);
+}
+
+// (\*|\d*)
+std::string_view payloadOrWildcard(Cursor& cursor)
+{
+  if (cursor.peek() == '*')
+  {
+    return cursor.span([first = true](char) mutable { return std::exchange(first, false); });
+  }
+  return digits(cursor);
+}
+
+// Matcher of a rule whose whole value is a single capture following |prefix|.
+template <typename Capture>
+bool prefixed(std::string_view content, Captures& captures, std::string_view prefix, Capture capture)
+{
+  Cursor cursor(content);
+  if (!cursor.literal(prefix))
+  {
+    return false;
+  }
+  captures[0] = capture(cursor);
+  return true;
+}
+
+// ^(flag)
+bool flag(std::string_view content, Captures& captures, std::string_view value)
+{
+  if (content.compare(0, value.size(), value) != 0)
+  {
+    return false;
+  }
+  captures[0] = content.substr(0, value.size());
+  return true;
+}
+
+bool hasValue(const json& o, const char* key)
+{
+  auto it = o.find(key);
+  if (it == o.end() || it->is_null())
+  {
+    return false;
+  }
+  return !it->is_string() || !it->get_ref<const std::string&>().empty();
+}
+
+struct Rule
+{
+  const char* name;
+  const char* push;
+  std::vector<const char*> names;
+  const char* types;
+  bool (*match)(std::string_view content, Captures& captures);
+  const char* format;
+  void (*formatFunc)(const json& o, std::string& format);
+};
+
+const std::vector<Rule>& rulesFor(char type)
+{
+  // clang-format off
+  static const std::vector<Rule> v = {
+    { "version", "", {}, "d",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        c[0] = digits(cursor);
+        return cursor.atEnd();
+      }, "%s", nullptr },
+  };
+  static const std::vector<Rule> o = {
+    { "origin", "", { "username", "sessionId", "sessionVersion", "netType", "ipVer", "address" }, "suusds",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        c[0] = nonSpace(cursor);
+        if (!cursor.character(' ')) return false;
+        c[1] = digits(cursor);
+        if (!cursor.character(' ')) return false;
+        c[2] = digits(cursor);
+        if (!cursor.character(' ')) return false;
+        c[3] = nonSpace(cursor);
+        if (!cursor.literal(" IP")) return false;
+        auto ipVer = cursor.span([n = 0](char ch) mutable { return n++ == 0 && isDigit(ch); });
+        if (ipVer.empty() || !cursor.character(' ')) return false;
+        c[4] = ipVer;
+        c[5] = nonSpace(cursor);
+        return true;
+      }, "%s %s %d %s IP%d %s", nullptr },
+  };
+  static const auto anything = [](std::string_view content, Captures& c) {
+    c[0] = content;
+    return true;
+  };
+  static const std::vector<Rule> s = { { "name", "", {}, "s", anything, "%s", nullptr } };
+  static const std::vector<Rule> i = { { "description", "", {}, "s", anything, "%s", nullptr } };
+  static const std::vector<Rule> u = { { "uri", "", {}, "s", anything, "%s", nullptr } };
+  static const std::vector<Rule> e = { { "email", "", {}, "s", anything, "%s", nullptr } };
+  static const std::vector<Rule> p = { { "phone", "", {}, "s", anything, "%s", nullptr } };
+  static const std::vector<Rule> z = { { "timezones", "", {}, "s", anything, "%s", nullptr } };
+  static const std::vector<Rule> r = { { "repeats", "", {}, "s", anything, "%s", nullptr } };
+  static const std::vector<Rule> t = {
+    { "timing", "", { "start", "stop" }, "dd",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        c[0] = digits(cursor);
+        if (!cursor.character(' ')) return false;
+        c[1] = digits(cursor);
+        return true;
+      }, "%d %d", nullptr },
+  };
+  static const std::vector<Rule> cLine = {
+    { "connection", "", { "version", "ip" }, "ds",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        if (!cursor.literal("IN IP") || !isDigit(cursor.peek())) return false;
+        c[0] = cursor.span([n = 0](char) mutable { return n++ == 0; });
+        if (!cursor.character(' ')) return false;
+        c[1] = nonSpace(cursor);
+        return true;
+      }, "IN IP%d %s", nullptr },
+  };
+  static const std::vector<Rule> b = {
+    { "", "bandwidth", { "type", "limit" }, "sd",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        auto type = cursor.oneOf({ "TIAS", "AS", "CT", "RR", "RS" });
+        if (!type || !cursor.character(':')) return false;
+        c[0] = type;
+        c[1] = digits(cursor);
+        return true;
+      }, "%s:%s", nullptr },
+  };
+  static const std::vector<Rule> m = {
+    { "", "", { "type", "port", "protocol", "payloads" }, "sdss",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        c[0] = cursor.span(isWord);
+        if (!cursor.character(' ')) return false;
+        c[1] = digits(cursor);
+        if (!cursor.character(' ')) return false;
+        c[2] = cursor.span([](char ch) { return isWord(ch) || ch == '/'; });
+        if (cursor.character(' ')) c[3] = cursor.rest();
+        return true;
+      }, "%s %d %s %s", nullptr },
+  };
+  static const std::vector<Rule> a = {
+    // a=rtpmap:110 opus/48000/2
+    { "", "rtp", { "payload", "codec", "rate", "encoding" }, "dsds",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        if (!cursor.literal("rtpmap:")) return false;
+        c[0] = digits(cursor);
+        if (!cursor.character(' ')) return false;
+        c[1] = cursor.span([](char ch) { return isWord(ch) || ch == '-' || ch == '.'; });
+        auto mark = cursor.pos();
+        cursor.span(isSpace);
+        if (!cursor.character('/'))
+        {
+          cursor.seek(mark);
+          return true;
+        }
+        c[2] = digits(cursor);
+        mark = cursor.pos();
+        cursor.span(isSpace);
+        if (cursor.character('/')) c[3] = nonSpace(cursor);
+        return true;
+      }, nullptr,
+      [](const json& o, std::string& f) {
+        f = hasValue(o, "encoding") ? "rtpmap:%d %s/%s/%s" : hasValue(o, "rate") ? "rtpmap:%d %s/%s" : "rtpmap:%d %s";
+      } },
+    // a=fmtp:108 profile-level-id=24;object=23;bitrate=64000
+    { "", "fmtp", { "payload", "config" }, "ds",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        if (!cursor.literal("fmtp:")) return false;
+        c[0] = digits(cursor);
+        if (!cursor.character(' ')) return false;
+        c[1] = nonSpaceOrBlank(cursor);
+        return true;
+      }, "fmtp:%d %s", nullptr },
+    // a=control:streamid=0
+    { "control", "", {}, "s",
+      [](std::string_view content, Captures& c) { return prefixed(content, c, "control:", [](Cursor& cursor) { return cursor.rest(); }); },
+      "control:%s", nullptr },
+    // a=rtcp:65179 IN IP4 193.84.77.194
+    { "rtcp", "", { "port", "netType", "ipVer", "address" }, "dsds",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        if (!cursor.literal("rtcp:")) return false;
+        c[0] = digits(cursor);
+        auto mark = cursor.pos();
+        if (cursor.character(' '))
+        {
+          auto netType = nonSpace(cursor);
+          if (cursor.literal(" IP") && isDigit(cursor.peek()))
+          {
+            auto ipVer = cursor.span([n = 0](char) mutable { return n++ == 0; });
+            if (cursor.character(' '))
+            {
+              c[1] = netType;
+              c[2] = ipVer;
+              c[3] = nonSpace(cursor);
+              return true;
+            }
+          }
+        }
+        cursor.seek(mark);
+        return true;
+      }, nullptr,
+      [](const json& o, std::string& f) { f = hasValue(o, "address") ? "rtcp:%d %s IP%d %s" : "rtcp:%d"; } },
+    // a=rtcp-fb:98 trr-int 100
+    { "", "rtcpFbTrrInt", { "payload", "value" }, "sd",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        if (!cursor.literal("rtcp-fb:")) return false;
+        c[0] = payloadOrWildcard(cursor);
+        if (!cursor.literal(" trr-int ")) return false;
+        c[1] = digits(cursor);
+        return true;
+      }, "rtcp-fb:%s trr-int %d", nullptr },
+    // a=rtcp-fb:98 nack rpsi
+    { "", "rtcpFb", { "payload", "type", "subtype" }, "sss",
+      [](std::string_view content, Captures& c) {
+        static const auto isFbChar = [](char ch) { return isWord(ch) || ch == '-'; };
+        Cursor cursor(content);
+        if (!cursor.literal("rtcp-fb:")) return false;
+        c[0] = payloadOrWildcard(cursor);
+        if (!cursor.character(' ')) return false;
+        c[1] = cursor.span(isFbChar);
+        if (cursor.character(' ')) c[2] = cursor.span(isFbChar);
+        return true;
+      }, nullptr,
+      [](const json& o, std::string& f) { f = hasValue(o, "subtype") ? "rtcp-fb:%s %s %s" : "rtcp-fb:%s %s"; } },
+    // a=extmap:2 urn:ietf:params:rtp-hdrext:toffset
+    // a=extmap:1/recvonly URI-gps-string
+    // a=extmap:3 urn:ietf:params:rtp-hdrext:encrypt urn:ietf:params:rtp-hdrext:smpte-tc 25@600/24
+    { "", "ext", { "value", "direction", "encrypt-uri", "uri", "config" }, "dssss",
+      [](std::string_view content, Captures& c) {
+        static constexpr std::string_view EncryptUri{ "urn:ietf:params:rtp-hdrext:encrypt" };
+        Cursor cursor(content);
+        if (!cursor.literal("extmap:")) return false;
+        auto value = digits(cursor);
+        if (value.empty()) return false;
+        c[0] = value;
+        auto mark = cursor.pos();
+        if (cursor.character('/'))
+        {
+          auto direction = cursor.span(isWord);
+          if (direction.empty())
+            cursor.seek(mark);
+          else
+            c[1] = direction;
+        }
+        mark = cursor.pos();
+        if (cursor.character(' ') && cursor.literal(EncryptUri) && cursor.peek() == ' ')
+          c[2] = EncryptUri;
+        else
+          cursor.seek(mark);
+        if (!cursor.character(' ')) return false;
+        c[3] = nonSpace(cursor);
+        c[4] = optionalToken(cursor);
+        return true;
+      }, nullptr,
+      [](const json& o, std::string& f) {
+        f = "extmap:%d";
+        f += hasValue(o, "direction") ? "/%s" : "%v";
+        f += hasValue(o, "encrypt-uri") ? " %s" : "%v";
+        f += " %s";
+        if (hasValue(o, "config")) f += " %s";
+      } },
+    // a=extmap-allow-mixed
+    { "extmapAllowMixed", "", {}, "s",
+      [](std::string_view content, Captures& c) { return flag(content, c, "extmap-allow-mixed"); },
+      "%s", nullptr },
+    // a=crypto:1 AES_CM_128_HMAC_SHA1_80 inline:PS1uQCVeeCFCanVmcjkpPywjNWhcYD0mXXtxaVBR|2^20|1:32
+    { "", "crypto", { "id", "suite", "config", "sessionConfig" }, "dsss",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        if (!cursor.literal("crypto:")) return false;
+        c[0] = digits(cursor);
+        if (!cursor.character(' ')) return false;
+        c[1] = cursor.span(isWord);
+        if (!cursor.character(' ')) return false;
+        c[2] = nonSpace(cursor);
+        c[3] = optionalToken(cursor);
+        return true;
+      }, nullptr,
+      [](const json& o, std::string& f) { f = hasValue(o, "sessionConfig") ? "crypto:%d %s %s %s" : "crypto:%d %s %s"; } },
+    // a=setup:actpass
+    { "setup", "", {}, "s",
+      [](std::string_view content, Captures& c) { return prefixed(content, c, "setup:", [](Cursor& cursor) { return cursor.span(isWord); }); },
+      "setup:%s", nullptr },
+    // a=connection:new
+    { "connectionType", "", {}, "s",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        if (!cursor.literal("connection:")) return false;
+        c[0] = cursor.oneOf({ "new", "existing" });
+        return c[0].has_value();
+      }, "connection:%s", nullptr },
+    // a=mid:1
+    { "mid", "", {}, "s",
+      [](std::string_view content, Captures& c) { return prefixed(content, c, "mid:", nonSpace); },
+      "mid:%s", nullptr },
+    // a=msid:0c8b064d-d807-43b4-b434-f92a889d8587 98178685-d409-46e0-8e16-7ef0db0db64a
+    { "msid", "", {}, "s",
+      [](std::string_view content, Captures& c) { return prefixed(content, c, "msid:", [](Cursor& cursor) { return cursor.rest(); }); },
+      "msid:%s", nullptr },
+    // a=ptime:20
+    { "ptime", "", {}, "f",
+      [](std::string_view content, Captures& c) { return prefixed(content, c, "ptime:", [](Cursor& cursor) { return cursor.span([](char ch) { return isDigit(ch) || ch == '.'; }); }); },
+      "ptime:%d", nullptr },
+    // a=maxptime:60
+    { "maxptime", "", {}, "f",
+      [](std::string_view content, Captures& c) { return prefixed(content, c, "maxptime:", [](Cursor& cursor) { return cursor.span([](char ch) { return isDigit(ch) || ch == '.'; }); }); },
+      "maxptime:%d", nullptr },
+    // a=sendrecv
+    { "direction", "", {}, "s",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        c[0] = cursor.oneOf({ "sendrecv", "recvonly", "sendonly", "inactive" });
+        return c[0].has_value();
+      }, "%s", nullptr },
+    // a=ice-lite
+    { "icelite", "", {}, "s",
+      [](std::string_view content, Captures& c) { return flag(content, c, "ice-lite"); },
+      "%s", nullptr },
+    // a=ice-ufrag:F7gI
+    { "iceUfrag", "", {}, "s",
+      [](std::string_view content, Captures& c) { return prefixed(content, c, "ice-ufrag:", nonSpace); },
+      "ice-ufrag:%s", nullptr },
+    // a=ice-pwd:x9cml/YzichV2+XlhiMu8g
+    { "icePwd", "", {}, "s",
+      [](std::string_view content, Captures& c) { return prefixed(content, c, "ice-pwd:", nonSpace); },
+      "ice-pwd:%s", nullptr },
+    // a=fingerprint:SHA-1 00:11:22:33:44:55:66:77:88:99:AA:BB:CC:DD:EE:FF:00:11:22:33
+    { "fingerprint", "", { "type", "hash" }, "ss",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        if (!cursor.literal("fingerprint:")) return false;
+        c[0] = nonSpace(cursor);
+        if (!cursor.character(' ')) return false;
+        c[1] = nonSpace(cursor);
+        return true;
+      }, "fingerprint:%s %s", nullptr },
+    // a=candidate:0 1 UDP 2113667327 203.0.113.1 54400 typ host
+    // a=candidate:1162875081 1 udp 2113937151 192.168.34.75 60017 typ host generation 0 network-id 3 network-cost 10
+    // a=candidate:3289912957 2 udp 1845501695 193.84.77.194 60017 typ srflx raddr 192.168.34.75 rport 60017 generation 0 network-id 3 network-cost 10
+    // a=candidate:229815620 1 tcp 1518280447 192.168.150.19 60017 typ host tcptype active generation 0 network-id 3 network-cost 10
+    { "", "candidates",
+      { "foundation", "component", "transport", "priority", "ip", "port", "type", "raddr", "rport", "tcptype", "generation", "network-id", "network-cost" },
+      "sdsusdssdsddd",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        if (!cursor.literal("candidate:")) return false;
+        c[0] = nonSpace(cursor);
+        if (!cursor.character(' ')) return false;
+        c[1] = digits(cursor);
+        if (!cursor.character(' ')) return false;
+        c[2] = nonSpace(cursor);
+        if (!cursor.character(' ')) return false;
+        c[3] = digits(cursor);
+        if (!cursor.character(' ')) return false;
+        c[4] = nonSpace(cursor);
+        if (!cursor.character(' ')) return false;
+        c[5] = digits(cursor);
+        if (!cursor.literal(" typ ")) return false;
+        c[6] = nonSpace(cursor);
+
+        auto mark = cursor.pos();
+        if (cursor.literal(" raddr "))
+        {
+          auto raddr = nonSpace(cursor);
+          if (cursor.literal(" rport "))
+          {
+            c[7] = raddr;
+            c[8] = digits(cursor);
+            mark = cursor.pos();
+          }
+        }
+        cursor.seek(mark);
+        if (cursor.literal(" tcptype "))
+        {
+          c[9] = nonSpace(cursor);
+          mark = cursor.pos();
+        }
+        cursor.seek(mark);
+        if (cursor.literal(" generation "))
+        {
+          c[10] = digits(cursor);
+          mark = cursor.pos();
+        }
+        cursor.seek(mark);
+        if (cursor.literal(" network-id "))
+        {
+          c[11] = digits(cursor);
+          mark = cursor.pos();
+        }
+        cursor.seek(mark);
+        if (cursor.literal(" network-cost "))
+        {
+          c[12] = digits(cursor);
+        }
+        return true;
+      }, nullptr,
+      [](const json& o, std::string& f) {
+        f = "candidate:%s %d %s %d %s %d typ %s";
+        f += hasValue(o, "raddr") ? " raddr %s rport %d" : "%v%v";
+        f += hasValue(o, "tcptype") ? " tcptype %s" : "%v";
+        f += hasValue(o, "generation") ? " generation %d" : "%v";
+        f += hasValue(o, "network-id") ? " network-id %d" : "%v";
+        f += hasValue(o, "network-cost") ? " network-cost %d" : "%v";
+      } },
+    // a=end-of-candidates
+    { "endOfCandidates", "", {}, "s",
+      [](std::string_view content, Captures& c) { return flag(content, c, "end-of-candidates"); },
+      "%s", nullptr },
+    // a=remote-candidates:1 203.0.113.1 54400 2 203.0.113.1 54401
+    { "remoteCandidates", "", {}, "s",
+      [](std::string_view content, Captures& c) { return prefixed(content, c, "remote-candidates:", [](Cursor& cursor) { return cursor.rest(); }); },
+      "remote-candidates:%s", nullptr },
+    // a=ice-options:google-ice
+    { "iceOptions", "", {}, "s",
+      [](std::string_view content, Captures& c) { return prefixed(content, c, "ice-options:", nonSpace); },
+      "ice-options:%s", nullptr },
+    // a=ssrc:2566107569 cname:t9YU8M1UxTF8Y1A1
+    { "", "ssrcs", { "id", "attribute", "value" }, "uss",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        if (!cursor.literal("ssrc:")) return false;
+        c[0] = digits(cursor);
+        if (!cursor.character(' ')) return false;
+        c[1] = cursor.span([](char ch) { return isWord(ch) || ch == '-'; });
+        if (cursor.character(':')) c[2] = cursor.rest();
+        return true;
+      }, nullptr,
+      [](const json& o, std::string& f) {
+        f = "ssrc:%d";
+        if (hasValue(o, "attribute"))
+        {
+          f += " %s";
+          if (hasValue(o, "value")) f += ":%s";
+        }
+      } },
+    // a=ssrc-group:FEC 1 2
+    // a=ssrc-group:FEC-FR 3004364195 1080772241
+    { "", "ssrcGroups", { "semantics", "ssrcs" }, "ss",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        if (!cursor.literal("ssrc-group:")) return false;
+        c[0] = cursor.span([](char ch) {
+          return isWord(ch) || ch == '!' || ch == '#' || ch == '$' || ch == '%' || ch == '&' || ch == '\'' || ch == '*' || ch == '+' || ch == '-' || ch == '.';
+        });
+        if (!cursor.character(' ')) return false;
+        c[1] = cursor.rest();
+        return true;
+      }, "ssrc-group:%s %s", nullptr },
+    // a=msid-semantic: WMS Jvlam5X3SX1OP6pn20zWogvaKJz5Hjf9OnlV
+    { "msidSemantic", "", { "semantic", "token" }, "ss",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        if (!cursor.literal("msid-semantic:")) return false;
+        if (isSpace(cursor.peek())) cursor.seek(cursor.pos() + 1);
+        c[0] = cursor.span(isWord);
+        if (!cursor.character(' ')) return false;
+        c[1] = nonSpace(cursor);
+        return true;
+      }, "msid-semantic: %s %s", nullptr },
+    // a=group:BUNDLE audio video
+    { "", "groups", { "type", "mids" }, "ss",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        if (!cursor.literal("group:")) return false;
+        c[0] = cursor.span(isWord);
+        if (!cursor.character(' ')) return false;
+        c[1] = cursor.rest();
+        return true;
+      }, "group:%s %s", nullptr },
+    // a=rtcp-mux
+    { "rtcpMux", "", {}, "s",
+      [](std::string_view content, Captures& c) { return flag(content, c, "rtcp-mux"); },
+      "%s", nullptr },
+    // a=rtcp-rsize
+    { "rtcpRsize", "", {}, "s",
+      [](std::string_view content, Captures& c) { return flag(content, c, "rtcp-rsize"); },
+      "%s", nullptr },
+    // a=sctpmap:5000 webrtc-datachannel 1024
+    { "sctpmap", "", { "sctpmapNumber", "app", "maxMessageSize" }, "dsd",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        if (!cursor.literal("sctpmap:")) return false;
+        c[0] = cursor.span([](char ch) { return isWord(ch) || ch == '/'; });
+        if (!cursor.character(' ')) return false;
+        c[1] = nonSpace(cursor);
+        c[2] = optionalToken(cursor);
+        return true;
+      }, nullptr,
+      [](const json& o, std::string& f) { f = hasValue(o, "maxMessageSize") ? "sctpmap:%s %s %s" : "sctpmap:%s %s"; } },
+    // a=x-google-flag:conference
+    { "xGoogleFlag", "", {}, "s",
+      [](std::string_view content, Captures& c) { return prefixed(content, c, "x-google-flag:", nonSpace); },
+      "x-google-flag:%s", nullptr },
+    // a=rid:1 send max-width=1280;max-height=720;max-fps=30;depend=0
+    { "", "rids", { "id", "direction", "params" }, "sss",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        if (!cursor.literal("rid:")) return false;
+        auto id = cursor.span(isWord);
+        if (id.empty() || !cursor.character(' ')) return false;
+        auto direction = cursor.span(isWord);
+        if (direction.empty()) return false;
+        c[0] = id;
+        c[1] = direction;
+        if (cursor.character(' ')) c[2] = nonSpaceOrBlank(cursor);
+        return true;
+      }, nullptr,
+      [](const json& o, std::string& f) { f = hasValue(o, "params") ? "rid:%s %s %s" : "rid:%s %s"; } },
+    // a=simulcast:send 1,2,3;~4,~5 recv 6;~7,~8
+    { "simulcast", "", { "dir1", "list1", "dir2", "list2" }, "ssss",
+      [](std::string_view content, Captures& c) {
+        static const auto isListChar = [](char ch) { return isWord(ch) || ch == '-' || ch == '~' || ch == ';' || ch == ','; };
+        Cursor cursor(content);
+        if (!cursor.literal("simulcast:")) return false;
+        auto dir1 = cursor.oneOf({ "send", "recv" });
+        if (!dir1 || !cursor.character(' ')) return false;
+        auto list1 = cursor.span(isListChar);
+        if (list1.empty()) return false;
+        c[0] = dir1;
+        c[1] = list1;
+        if (cursor.atEnd()) return true;
+        if (isSpace(cursor.peek())) cursor.seek(cursor.pos() + 1);
+        auto dir2 = cursor.oneOf({ "send", "recv" });
+        if (!dir2 || !cursor.character(' ')) return false;
+        auto list2 = cursor.span(isListChar);
+        if (list2.empty() || !cursor.atEnd()) return false;
+        c[2] = dir2;
+        c[3] = list2;
+        return true;
+      }, nullptr,
+      [](const json& o, std::string& f) {
+        f = "simulcast:%s %s";
+        if (hasValue(o, "dir2")) f += " %s %s";
+      } },
+    // Old simulcast draft 03 (implemented by Firefox).
+    // a=simulcast: recv pt=97;98 send pt=97
+    { "simulcast_03", "", { "value" }, "s",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        if (!cursor.literal("simulcast:") || cursor.span(isSpace).empty()) return false;
+        auto value = cursor.rest();
+        if (value.empty()) return false;
+        c[0] = value;
+        return true;
+      }, "simulcast: %s", nullptr },
+    // a=framerate:25
+    // a=framerate:29.97
+    { "framerate", "", {}, "f",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        if (!cursor.literal("framerate:")) return false;
+        auto start = cursor.pos();
+        if (digits(cursor).empty()) return false;
+        if (!cursor.atEnd())
+        {
+          if (!cursor.character('.') || digits(cursor).empty()) return false;
+        }
+        c[0] = content.substr(start, cursor.pos() - start);
+        return true;
+      }, "framerate:%s", nullptr },
+    // a=source-filter: incl IN IP4 239.5.2.31 10.1.15.5
+    { "sourceFilter", "", { "filterMode", "netType", "addressTypes", "destAddress", "srcList" }, "sssss",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        if (!cursor.literal("source-filter:")) return false;
+        cursor.span([](char ch) { return ch == ' '; });
+        c[0] = cursor.oneOf({ "excl", "incl" });
+        if (!c[0] || !cursor.character(' ')) return false;
+        c[1] = nonSpace(cursor);
+        if (!cursor.character(' ')) return false;
+        c[2] = cursor.oneOf({ "IP4", "IP6", "*" });
+        if (!c[2] || !cursor.character(' ')) return false;
+        c[3] = nonSpace(cursor);
+        if (!cursor.character(' ')) return false;
+        c[4] = cursor.rest();
+        return true;
+      }, "source-filter: %s %s %s %s %s", nullptr },
+    // a=bundle-only
+    { "bundleOnly", "", {}, "s",
+      [](std::string_view content, Captures& c) { return flag(content, c, "bundle-only"); },
+      "%s", nullptr },
+    // a=label:1
+    { "label", "", {}, "s",
+      [](std::string_view content, Captures& c) { return prefixed(content, c, "label:", [](Cursor& cursor) { return cursor.rest(); }) && !c[0]->empty(); },
+      "label:%s", nullptr },
+    // a=sctp-port:5000
+    { "sctpPort", "", {}, "d",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        if (!cursor.literal("sctp-port:")) return false;
+        c[0] = digits(cursor);
+        return !c[0]->empty() && cursor.atEnd();
+      }, "sctp-port:%s", nullptr },
+    // a=max-message-size:262144
+    { "maxMessageSize", "", {}, "d",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        if (!cursor.literal("max-message-size:")) return false;
+        c[0] = digits(cursor);
+        return !c[0]->empty() && cursor.atEnd();
+      }, "max-message-size:%s", nullptr },
+    // a=ts-refclk:ptp=IEEE1588-2008:00-50-C2-FF-FE-90-04-37:0
+    { "", "tsRefClocks", { "clksrc", "clksrcExt" }, "ss",
+      [](std::string_view content, Captures& c) {
+        Cursor cursor(content);
+        if (!cursor.literal("ts-refclk:")) return false;
+        c[0] = cursor.span([](char ch) { return ch != '=' && !isSpace(ch); });
+        if (cursor.character('=')) c[1] = nonSpace(cursor);
+        return true;
+      }, nullptr,
+      [](const json& o, std::string& f) { f = hasValue(o, "clksrcExt") ? "ts-refclk:%s=%s" : "ts-refclk:%s"; } },
+    // a=keywds:keywords
+    { "keywords", "", {}, "s",
+      [](std::string_view content, Captures& c) { return prefixed(content, c, "keywds:", [](Cursor& cursor) { return cursor.rest(); }) && !c[0]->empty(); },
+      "keywds:%s", nullptr },
+    // a=content:main
+    { "content", "", {}, "s",
+      [](std::string_view content, Captures& c) { return prefixed(content, c, "content:", [](Cursor& cursor) { return cursor.rest(); }) && !c[0]->empty(); },
+      "content:%s", nullptr },
+    // Any a= that we don't understand is kept verbatim on invalid.
+    { "", "invalid", { "value" }, "s", anything, "%s", nullptr },
+  };
+  // clang-format on
+  static const std::vector<Rule> none;
+
+  switch (type)
+  {
+    case 'v':
+      return v;
+    case 'o':
+      return o;
+    case 's':
+      return s;
+    case 'i':
+      return i;
+    case 'u':
+      return u;
+    case 'e':
+      return e;
+    case 'p':
+      return p;
+    case 'z':
+      return z;
+    case 'r':
+      return r;
+    case 't':
+      return t;
+    case 'c':
+      return cLine;
+    case 'b':
+      return b;
+    case 'm':
+      return m;
+    case 'a':
+      return a;
+    default:
+      return none;
+  }
+}
+
+template <typename T>
+std::optional<T> toInteger(std::string_view value)
+{
+  T result{};
+  auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+  if (ec != std::errc() || ptr != value.data() + value.size() || value.empty())
+  {
+    return std::nullopt;
+  }
+  return result;
+}
+
+json toType(std::string_view value, char type)
+{
+  switch (type)
+  {
+    case 'u':
+      return toInteger<unsigned long long>(value).value_or(0u);
+    case 'd':
+      return toInteger<long long>(value).value_or(0);
+    case 'f':
+    {
+      std::string str(value);
+      char* end = nullptr;
+      auto result = std::strtod(str.c_str(), &end);
+      return (!str.empty() && end == str.c_str() + str.size()) ? result : 0.0;
+    }
+    default:
+      return std::string(value);
+  }
+}
+
+void attachProperties(const Rule& rule, json& location, const Captures& captures)
+{
+  bool needsBlank = *rule.name && !rule.names.empty();
+
+  if (*rule.push && location.find(rule.push) == location.end())
+  {
+    location[rule.push] = json::array();
+  }
+  else if (needsBlank && location.find(rule.name) == location.end())
+  {
+    location[rule.name] = json::object();
+  }
+
+  json object = json::object();
+  json& keyLocation = *rule.push ? object : needsBlank ? location[rule.name] : location;
+
+  if (*rule.name && rule.names.empty())
+  {
+    keyLocation[rule.name] = toType(*captures[0], rule.types[0]);
+  }
+  else
+  {
+    for (size_t i = 0; i < rule.names.size(); ++i)
+    {
+      if (captures[i])
+      {
+        keyLocation[rule.names[i]] = toType(*captures[i], rule.types[i]);
+      }
+    }
+  }
+
+  if (*rule.push)
+  {
+    location[rule.push].push_back(std::move(object));
+  }
+}
+
+void appendValue(std::string& sdp, const json& value)
+{
+  char buffer[32];
+  switch (value.type())
+  {
+    case json::value_t::string:
+      sdp += value.get_ref<const std::string&>();
+      break;
+    case json::value_t::number_integer:
+    {
+      auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value.get<int64_t>());
+      sdp.append(buffer, ptr);
+      break;
+    }
+    case json::value_t::number_unsigned:
+    {
+      auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value.get<uint64_t>());
+      sdp.append(buffer, ptr);
+      break;
+    }
+    case json::value_t::number_float:
+    {
+      auto length = std::snprintf(buffer, sizeof(buffer), "%.15g", value.get<double>());
+      sdp.append(buffer, static_cast<size_t>(length));
+      break;
+    }
+    case json::value_t::boolean:
+      sdp += value.get<bool>() ? "true" : "false";
+      break;
+    case json::value_t::null:
+    case json::value_t::discarded:
+      break;
+    default:
+      sdp += value.dump();
+      break;
+  }
+}
+
+void makeLine(std::string& sdp, std::string& scratch, char type, const Rule& rule, const json& location)
+{
+  static const json Null;
+
+  const json& formatTarget = *rule.push ? location : *rule.name ? location.at(rule.name) : location;
+  const char* format = rule.format;
+  if (rule.formatFunc != nullptr)
+  {
+    rule.formatFunc(formatTarget, scratch);
+    format = scratch.c_str();
+  }
+
+  // Values substituted into the format, in order.
+  auto arg = [&](size_t index) -> const json& {
+    if (rule.names.empty())
+    {
+      return index == 0 ? location.at(rule.name) : Null;
+    }
+    if (index >= rule.names.size())
+    {
+      return Null;
+    }
+    const json& target = *rule.name ? location.at(rule.name) : location;
+    auto it = target.find(rule.names[index]);
+    return it == target.end() ? Null : *it;
+  };
+  size_t argCount = rule.names.empty() ? 1 : rule.names.size();
+
+  sdp += type;
+  sdp += '=';
+
+  size_t index = 0;
+  for (const char* c = format; *c != '\0'; ++c)
+  {
+    if (*c != '%' || (c[1] != 's' && c[1] != 'd' && c[1] != 'v' && c[1] != '%'))
+    {
+      sdp += *c;
+      continue;
+    }
+
+    char conversion = *++c;
+    if (index >= argCount)
+    {
+      // Missing argument, keep the placeholder.
+      sdp += '%';
+      sdp += conversion;
+      continue;
+    }
+
+    const json& value = arg(index++);
+    if (conversion == '%')
+    {
+      sdp += '%';
+    }
+    else if (conversion != 'v')
+    {
+      appendValue(sdp, value);
+    }
+  }
+
+  sdp += "\r\n";
+}
+
+void writeRules(std::string& sdp, std::string& scratch, char type, const json& location)
+{
+  for (const auto& rule : rulesFor(type))
+  {
+    if (*rule.name)
+    {
+      auto it = location.find(rule.name);
+      if (it != location.end() && !it->is_null())
+      {
+        makeLine(sdp, scratch, type, rule, location);
+      }
+    }
+    else if (*rule.push)
+    {
+      auto it = location.find(rule.push);
+      if (it != location.end() && it->is_array())
+      {
+        for (const auto& element : *it)
+        {
+          makeLine(sdp, scratch, type, rule, element);
+        }
+      }
+    }
+  }
+}
+
+std::vector<std::string_view> split(std::string_view str, char delimiter)
+{
+  std::vector<std::string_view> result;
+  size_t start = 0;
+  while (true)
+  {
+    auto end = str.find(delimiter, start);
+    result.push_back(str.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start));
+    if (end == std::string_view::npos)
+    {
+      break;
+    }
+    start = end + 1;
+  }
+  return result;
+}
+
+std::string_view trim(std::string_view str)
+{
+  while (!str.empty() && isSpace(str.front()))
+  {
+    str.remove_prefix(1);
+  }
+  while (!str.empty() && isSpace(str.back()))
+  {
+    str.remove_suffix(1);
+  }
+  return str;
+}
+
+bool isInt(std::string_view str)
+{
+  if (!str.empty() && str.front() == '-')
+  {
+    str.remove_prefix(1);
+  }
+  if (str.empty())
+  {
+    return false;
+  }
+  for (auto c : str)
+  {
+    if (!isDigit(c))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool isFloat(std::string_view str)
+{
+  if (!str.empty() && str.front() == '-')
+  {
+    str.remove_prefix(1);
+  }
+  auto dot = str.find('.');
+  if (dot == std::string_view::npos || dot + 1 == str.size())
+  {
+    return false;
+  }
+  return (dot == 0 || isInt(str.substr(0, dot))) && isInt(str.substr(dot + 1));
+}
+
+// Codec parameters whose value must keep its type whatever it looks like.
+char wellKnownParameterType(std::string_view param)
+{
+  if (param == "profile-level-id" || param == "profile-id")
+  {
+    return 's';
+  }
+  if (param == "packetization-mode")
+  {
+    return 'd';
+  }
+  return '\0';
+}
+
+// ^\s*([^= ]+)(?:\s*=\s*([^ ]+))?$
+void insertParam(json& o, std::string_view str)
+{
+  Cursor cursor(str);
+  cursor.span(isSpace);
+  auto param = cursor.span([](char c) { return c != '=' && c != ' '; });
+  if (param.empty())
+  {
+    return;
+  }
+
+  std::string_view value;
+  auto mark = cursor.pos();
+  cursor.span(isSpace);
+  if (cursor.character('='))
+  {
+    cursor.span(isSpace);
+    value = cursor.span([](char c) { return c != ' '; });
+    if (value.empty())
+    {
+      return;
+    }
+  }
+  else
+  {
+    cursor.seek(mark);
+  }
+  if (!cursor.atEnd())
+  {
+    return;
+  }
+
+  char type = wellKnownParameterType(param);
+  if (type == '\0')
+  {
+    type = isInt(value) ? 'd' : isFloat(value) ? 'f' : 's';
+  }
+  o[std::string(param)] = toType(value, type);
+}
+
+thread_local WriteCache* currentCache = nullptr;
+
+// Stamps are unique in the process, so a section copied elsewhere never matches the text kept for the original.
+std::atomic<uint64_t> nextStamp{ 1 };
+
+// Not a grammar property, so the writer ignores it.
+constexpr char StampKey[] = "mscWriteStamp";
+
+uint64_t stampOf(const json& o)
+{
+  auto it = o.find(StampKey);
+  return it != o.end() && it->is_number_unsigned() ? it->get<uint64_t>() : 0;
+}
+
+uint64_t stamp(json& o)
+{
+  auto value = nextStamp.fetch_add(1, std::memory_order_relaxed);
+  o[StampKey] = value;
+  return value;
+}
+
+void writeMediaSection(std::string& sdp, std::string& scratch, const json& mLine)
+{
+  static constexpr char InnerOrder[] = { 'i', 'c', 'b', 'a' };
+
+  makeLine(sdp, scratch, 'm', rulesFor('m').front(), mLine);
+  for (auto type : InnerOrder)
+  {
+    writeRules(sdp, scratch, type, mLine);
+  }
+}
+
+} // namespace
+
+json parse(const std::string& sdp)
+{
+  json session = json::object();
+  json media = json::array();
+  json* location = std::addressof(session);
+  std::string_view text(sdp);
+
+  size_t start = 0;
+  while (start < text.size())
+  {
+    auto end = text.find('\n', start);
+    if (end == std::string_view::npos)
+    {
+      end = text.size();
+    }
+    auto line = text.substr(start, end - start);
+    start = end + 1;
+
+    // Remove \r if lines are separated with \r\n (as mandated in SDP).
+    if (!line.empty() && line.back() == '\r')
+    {
+      line.remove_suffix(1);
+    }
+
+    // Ensure it's a valid SDP line.
+    if (line.size() < 2 || line[0] < 'a' || line[0] > 'z' || line[1] != '=')
+    {
+      continue;
+    }
+
+    char type = line[0];
+    auto content = line.substr(2);
+
+    if (type == 'm')
+    {
+      json m = json::object();
+      m["rtp"] = json::array();
+      m["fmtp"] = json::array();
+      media.push_back(std::move(m));
+
+      // Point at latest media line.
+      location = std::addressof(media[media.size() - 1]);
+    }
+
+    for (const auto& rule : rulesFor(type))
+    {
+      Captures captures;
+      if (rule.match(content, captures))
+      {
+        attachProperties(rule, *location, captures);
+        break;
+      }
+    }
+  }
+
+  // Link it up.
+  session["media"] = std::move(media);
+
+  return session;
+}
+
+json parseParams(const std::string& str)
+{
+  json obj = json::object();
+  for (auto param : split(str, ';'))
+  {
+    param = trim(param);
+    if (!param.empty())
+    {
+      insertParam(obj, param);
+    }
+  }
+  return obj;
+}
+
+std::vector<int> parsePayloads(const std::string& str)
+{
+  std::vector<int> arr;
+  for (auto payload : split(str, ' '))
+  {
+    arr.push_back(std::stoi(std::string(payload)));
+  }
+  return arr;
+}
+
+json parseImageAttributes(const std::string& str)
+{
+  json arr = json::array();
+  for (auto item : split(str, ' '))
+  {
+    if (item.size() < 2)
+    {
+      continue;
+    }
+    json obj = json::object();
+    for (auto param : split(item.substr(1, item.size() - 2), ','))
+    {
+      insertParam(obj, param);
+    }
+    arr.push_back(std::move(obj));
+  }
+  return arr;
+}
+
+json parseSimulcastStreamList(const std::string& str)
+{
+  json arr = json::array();
+  for (auto stream : split(str, ';'))
+  {
+    json formats = json::array();
+    for (auto format : split(stream, ','))
+    {
+      bool paused = !format.empty() && format.front() == '~';
+      if (paused)
+      {
+        format.remove_prefix(1);
+      }
+      formats.push_back({ { "scid", std::string(format) }, { "paused", paused } });
+    }
+    arr.push_back(std::move(formats));
+  }
+  return arr;
+}
+
+std::string write(json& session)
+{
+  // RFC specified order.
+  static constexpr char OuterOrder[] = { 'v', 'o', 's', 'i', 'u', 'e', 'p', 'c', 'b', 't', 'r', 'z', 'a' };
+
+  // Ensure certain properties exist.
+  if (session.find("version") == session.end())
+  {
+    session["version"] = 0;
+  }
+  if (session.find("name") == session.end())
+  {
+    session["name"] = "-";
+  }
+  if (session.find("media") == session.end())
+  {
+    session["media"] = json::array();
+  }
+  for (auto& mLine : session["media"])
+  {
+    if (mLine.find("payloads") == mLine.end())
+    {
+      mLine["payloads"] = "";
+    }
+  }
+
+  std::string sdp;
+  std::string scratch;
+  sdp.reserve(4096);
+
+  for (auto type : OuterOrder)
+  {
+    writeRules(sdp, scratch, type, session);
+  }
+
+  auto* cache = WriteCacheScope::current();
+  if (cache == nullptr)
+  {
+    for (const auto& mLine : session["media"])
+    {
+      writeMediaSection(sdp, scratch, mLine);
+    }
+    return sdp;
+  }
+
+  // Only the sections of a session written before are kept, RemoteSdp writes its session again on each negotiation
+  // while the local descriptions are parsed and written once.
+  auto sessionStamp = stampOf(session);
+  bool rewritten = sessionStamp != 0;
+  if (!rewritten)
+  {
+    sessionStamp = stamp(session);
+  }
+  auto previous = cache->take(sessionStamp);
+  WriteCache::Session current{ sessionStamp, {}, 0 };
+
+  for (auto& mLine : session["media"])
+  {
+    if (!mLine.is_object())
+    {
+      writeMediaSection(sdp, scratch, mLine);
+      continue;
+    }
+
+    const void* object = &mLine.get_ref<const json::object_t&>();
+    auto it = previous.sections.find(stampOf(mLine));
+    if (it != previous.sections.end() && it->second.object == object)
+    {
+      sdp += it->second.text;
+      current.bytes += it->second.text.size();
+      current.sections.insert(previous.sections.extract(it));
+      continue;
+    }
+
+    auto start = sdp.size();
+    writeMediaSection(sdp, scratch, mLine);
+    auto sectionStamp = stamp(mLine);
+    auto size = sdp.size() - start;
+    if (rewritten && current.bytes + size <= WriteCache::kMaxSessionBytes)
+    {
+      current.sections.emplace(sectionStamp, WriteCache::Section{ object, sdp.substr(start) });
+      current.bytes += size;
+    }
+  }
+
+  if (!current.sections.empty())
+  {
+    cache->put(std::move(current));
+  }
+
+  return sdp;
+}
+
+WriteCache::Session WriteCache::take(uint64_t stamp)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto it = std::find_if(sessions_.begin(), sessions_.end(), [stamp](const Session& session) { return session.stamp == stamp; });
+  if (it == sessions_.end())
+  {
+    return {};
+  }
+  auto session = std::move(*it);
+  sessions_.erase(it);
+  return session;
+}
+
+void WriteCache::put(Session session)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (sessions_.size() >= kMaxSessions)
+  {
+    sessions_.pop_back();
+  }
+  sessions_.insert(sessions_.begin(), std::move(session));
+}
+
+void WriteCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  sessions_.clear();
+}
+
+WriteCacheScope::WriteCacheScope(WriteCache& cache) : previous_(currentCache)
+{
+  currentCache = &cache;
+}
+
+WriteCacheScope::~WriteCacheScope()
+{
+  currentCache = previous_;
+}
+
+WriteCache* WriteCacheScope::current()
+{
+  return currentCache;
+}
+
+} // namespace sdptransform
@@ -0,0 +1,73 @@
+#ifndef SDP_TRANSFORM_H_
+#define SDP_TRANSFORM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Additions of the handwritten sdptransform built with MEDIASOUPCLIENT_FAST_SDP.
+namespace sdptransform
+{
+
+// Text of the media sections written for one transport, reused by write() while a WriteCacheScope of it is active.
+// write() stamps each section it writes, and reuses the text as long as the section keeps its stamp and its storage.
+// RemoteSdp replaces a section whenever it changes, so nothing is compared; sections edited in place would be missed.
+class WriteCache final
+{
+public:
+  struct Section
+  {
+    // Storage of the section when it was written.
+    const void* object;
+    std::string text;
+  };
+
+  struct Session
+  {
+    uint64_t stamp{ 0 };
+    std::unordered_map<uint64_t, Section> sections;
+    size_t bytes{ 0 };
+  };
+
+  // Bounds the text kept for a single session.
+  static constexpr size_t kMaxSessionBytes = 2 * 1024 * 1024;
+
+  // Removes and returns what is kept for the session |stamp|, nothing when it was not written in this cache before.
+  Session take(uint64_t stamp);
+
+  // Keeps the sections of a session, in place of the least recently written one when full.
+  void put(Session session);
+
+  void clear();
+
+private:
+  // The remote session of the transport, and a spare one.
+  static constexpr size_t kMaxSessions = 2;
+
+  std::mutex mutex_;
+  std::vector<Session> sessions_;
+};
+
+// Makes |cache| the cache of the write() calls of the current thread while in scope. Scopes nest.
+// Without a scope, write() stamps nothing and writes every section.
+class WriteCacheScope final
+{
+public:
+  explicit WriteCacheScope(WriteCache& cache);
+  ~WriteCacheScope();
+
+  WriteCacheScope(const WriteCacheScope&) = delete;
+  WriteCacheScope& operator=(const WriteCacheScope&) = delete;
+
+  static WriteCache* current();
+
+private:
+  WriteCache* previous_;
+};
+
+} // namespace sdptransform
+
+#endif // SDP_TRANSFORM_H_
@@ -10,11 +10,17 @@
 #include <Logger.hpp>
 #include <Transport.hpp>
 #include <future>
+#include <stdexcept>
 #include <thread>
 
 #include "data_producer.h"
 #include "jni_util.h"
+#include "json_parser.h"
+#include "negotiation_scope.h"
+#include "transport_lock.h"
+#ifndef MSC_DATA_ONLY
 #include "producer.h"
+#endif
 
 using namespace webrtc;
 
@@ -29,14 +35,41 @@ extern jmethodID transportListenerOnConnectionStateChangeMethod;
 extern jmethodID sendTransportListenerOnProduceMethod;
 extern jmethodID sendTransportListenerOnProduceDataMethod;
 
+namespace
+{
+
+// Hands the kept appData to OnProduce() / OnProduceData() for one produce call, and takes it back also when the call throws.
+class PendingAppDataScope final
+{
+public:
+  PendingAppDataScope(SendTransportListenerJni* listener, jstring j_appData) : listener_(listener) { listener_->SetPendingAppData(j_appData); }
+  ~PendingAppDataScope() { listener_->SetPendingAppData(nullptr); }
+
+  PendingAppDataScope(const PendingAppDataScope&) = delete;
+  PendingAppDataScope& operator=(const PendingAppDataScope&) = delete;
+
+private:
+  SendTransportListenerJni* const listener_;
+};
+
+} // namespace
+
 extern "C"
 {
+#ifndef MSC_DATA_ONLY
   JNI_DEFINE_METHOD(jobject, SendTransport, nativeProduce, jlong j_transport, jobject j_listener, jlong j_track, jobjectArray j_encodings, jstring j_codecOptions, jstring j_codec, jstring j_appData)
   {
     MSC_TRACE();
 
+    auto* ownedTransport = getOwnedTransport(j_transport);
+    NegotiationScope scope("SendTransport.produce", ownedTransport->usage().get());
+
     return handleNativeCrash(env,
                              [&]() {
+                               if (ownedTransport->dataOnly())
+                               {
+                                 throw std::logic_error("cannot produce media with a data-only Device");
+                               }
                                auto listener = new ProducerListenerJni(env, JavaParamRef<jobject>(env, j_listener));
                                auto track = webrtc::scoped_refptr(reinterpret_cast<webrtc::MediaStreamTrackInterface*>(j_track));
                                std::vector<RtpEncodingParameters> encodings;
@@ -47,43 +80,69 @@ extern "C"
                                auto codecOptions = json::object();
                                if (j_codecOptions != nullptr)
                                {
-                                 codecOptions = json::parse(JavaToNativeString(env, JavaParamRef<jstring>(env, j_codecOptions)));
+                                 codecOptions = JavaToNativeJson(env, JavaParamRef<jstring>(env, j_codecOptions));
                                }
                                json codec = nullptr;
                                if (j_codec != nullptr)
                                {
-                                 codec = json::parse(JavaToNativeString(env, JavaParamRef<jstring>(env, j_codec)));
+                                 codec = JavaToNativeJson(env, JavaParamRef<jstring>(env, j_codec));
                                }
-                               json appData = nullptr;
-                               if (j_appData != nullptr)
+                               AppData keptAppData(env, j_appData, ownedTransport->appData().opaque());
+                               json appData = keptAppData.opaque() ? json::object() : json(nullptr);
+                               if (j_appData != nullptr && !keptAppData.opaque())
                                {
-                                 appData = json::parse(JavaToNativeString(env, JavaParamRef<jstring>(env, j_appData)));
+                                 appData = JavaToNativeJson(env, JavaParamRef<jstring>(env, j_appData));
                                }
 
+                               // OnProduce() runs within Produce() and hands the kept string to the listener.
+                               TransportLock lock(*ownedTransport->mutex());
+                               SdpWriteScope sdpWrite(*ownedTransport);
+                               PendingAppDataScope pendingAppData(static_cast<OwnedSendTransport*>(ownedTransport)->listener(), keptAppData.obj());
                                auto producer = getSendTransport(j_transport)->Produce(listener, track, &encodings, &codecOptions, &codec, appData);
-                               return NativeToJavaProducer(env, producer, listener).Release();
+                               return NativeToJavaProducer(env, producer, listener, UsageToken(ownedTransport->usage(), DeviceUsage::kProducers), std::move(keptAppData),
+                                                           ownedTransport->mutex())
+                                 .Release();
                              })
       .value_or(nullptr);
   }
+#else
+  // Registered in the data-only build too, so that produce() throws MediasoupException rather than UnsatisfiedLinkError.
+  JNI_DEFINE_METHOD(jobject, SendTransport, nativeProduce, jlong, jobject, jlong, jobjectArray, jstring, jstring, jstring)
+  {
+    MSC_TRACE();
+
+    throwMediasoupException(env, "produce is not available in the data-only build");
+    return nullptr;
+  }
+#endif
 
   JNI_DEFINE_METHOD(jobject, SendTransport, nativeProduceData, jlong j_transport, jobject j_listener, jstring j_label, jstring j_protocol, jboolean j_ordered, jint j_maxRetransmits,
                     jint j_maxPacketLifeTime, jstring j_appData)
   {
     MSC_TRACE();
 
+    auto* ownedTransport = getOwnedTransport(j_transport);
+    NegotiationScope scope("SendTransport.produceData", ownedTransport->usage().get());
+
     return handleNativeCrash(env,
                              [&]() {
                                auto listener = new DataProducerListenerJni(env, JavaParamRef<jobject>(env, j_listener));
                                auto label = JavaToNativeString(env, JavaParamRef<jstring>(env, j_label));
                                auto protocol = JavaToNativeString(env, JavaParamRef<jstring>(env, j_protocol));
-                               json appData = nullptr;
-                               if (j_appData != nullptr)
+                               AppData keptAppData(env, j_appData, ownedTransport->appData().opaque());
+                               json appData = keptAppData.opaque() ? json::object() : json(nullptr);
+                               if (j_appData != nullptr && !keptAppData.opaque())
                                {
-                                 appData = json::parse(JavaToNativeString(env, JavaParamRef<jstring>(env, j_appData)));
+                                 appData = JavaToNativeJson(env, JavaParamRef<jstring>(env, j_appData));
                                }
 
+                               TransportLock lock(*ownedTransport->mutex());
+                               SdpWriteScope sdpWrite(*ownedTransport);
+                               PendingAppDataScope pendingAppData(static_cast<OwnedSendTransport*>(ownedTransport)->listener(), keptAppData.obj());
                                auto dataProducer = getSendTransport(j_transport)->ProduceData(listener, label, protocol, j_ordered, j_maxRetransmits, j_maxPacketLifeTime, appData);
-                               return NativeToJavaDataProducer(env, dataProducer, listener).Release();
+                               return NativeToJavaDataProducer(env, dataProducer, listener, UsageToken(ownedTransport->usage(), DeviceUsage::kDataProducers), std::move(keptAppData),
+                                                               ownedTransport->mutex())
+                                 .Release();
                              })
       .value_or(nullptr);
   }
@@ -93,11 +152,14 @@ std::future<void> SendTransportListenerJni::OnConnect(Transport*, const json& dt
 {
   MSC_TRACE();
 
+  // Waited for with the transport locked: the handler is in the middle of its first negotiation,
+  // and another operation would find the transport not connected yet and connect it again.
   return std::async(
     std::launch::async,
     [](const jobject& j_listener, const jobject& j_transport, const json& dtlsParameters) {
       JNIEnv* env = webrtc::AttachCurrentThreadIfNeeded();
-      env->CallVoidMethod(j_listener, transportListenerOnConnectMethod, j_transport, NativeToJavaString(env, dtlsParameters.dump()).obj());
+      NegotiationScope scope("SendTransport.onConnect");
+      env->CallVoidMethod(j_listener, transportListenerOnConnectMethod, j_transport, NativeToJavaJson(env, dtlsParameters).obj());
     },
     j_listener_.obj(), j_transport_.obj(), dtlsParameters);
 }
@@ -114,30 +176,36 @@ std::future<std::string> SendTransportListenerJni::OnProduce(SendTransport*, con
 {
   MSC_TRACE();
 
-  return std::async(
+  // The local negotiation is done by now, so the transport is free for other operations while the app signals the producer.
+  return TransportLock::releasedWhileWaiting(std::async(
     std::launch::async,
-    [](const jobject& j_listener, const jobject& j_transport, const std::string& kind, const json& rtpParameters, const json& appData) {
+    [](const jobject& j_listener, const jobject& j_transport, const std::string& kind, const json& rtpParameters, const json& appData, jstring j_appData) {
       JNIEnv* env = webrtc::AttachCurrentThreadIfNeeded();
-      auto result = env->CallObjectMethod(j_listener, sendTransportListenerOnProduceMethod, j_transport, NativeToJavaString(env, kind).obj(), NativeToJavaString(env, rtpParameters.dump()).obj(),
-                                          NativeToJavaString(env, appData.dump()).obj());
+      NegotiationScope scope("SendTransport.onProduce");
+      auto j_appDataJson = j_appData == nullptr ? NativeToJavaJson(env, appData) : ScopedJavaLocalRef<jstring>();
+      auto result = env->CallObjectMethod(j_listener, sendTransportListenerOnProduceMethod, j_transport, NativeToJavaString(env, kind).obj(), NativeToJavaJson(env, rtpParameters).obj(),
+                                          j_appData == nullptr ? j_appDataJson.obj() : j_appData);
       return JavaToNativeString(env, ScopedJavaLocalRef<jstring>(env, static_cast<jstring>(result)));
     },
-    j_listener_.obj(), j_transport_.obj(), kind, rtpParameters, appData);
+    j_listener_.obj(), j_transport_.obj(), kind, rtpParameters, appData, j_pendingAppData_));
 }
 
 std::future<std::string> SendTransportListenerJni::OnProduceData(SendTransport*, const json& sctpStreamParameters, const std::string& label, const std::string& protocol, const json& appData)
 {
   MSC_TRACE();
 
-  return std::async(
+  return TransportLock::releasedWhileWaiting(std::async(
     std::launch::async,
-    [](const jobject& j_listener, const jobject& j_transport, const json& sctpStreamParameters, const std::string& label, const std::string& protocol, const json& appData) {
+    [](const jobject& j_listener, const jobject& j_transport, const json& sctpStreamParameters, const std::string& label, const std::string& protocol, const json& appData,
+       jstring j_appData) {
       JNIEnv* env = webrtc::AttachCurrentThreadIfNeeded();
-      auto result = env->CallObjectMethod(j_listener, sendTransportListenerOnProduceDataMethod, j_transport, NativeToJavaString(env, sctpStreamParameters.dump()).obj(),
-                                          NativeToJavaString(env, label).obj(), NativeToJavaString(env, protocol).obj(), NativeToJavaString(env, appData.dump()).obj());
+      NegotiationScope scope("SendTransport.onProduceData");
+      auto j_appDataJson = j_appData == nullptr ? NativeToJavaJson(env, appData) : ScopedJavaLocalRef<jstring>();
+      auto result = env->CallObjectMethod(j_listener, sendTransportListenerOnProduceDataMethod, j_transport, NativeToJavaJson(env, sctpStreamParameters).obj(),
+                                          NativeToJavaString(env, label).obj(), NativeToJavaString(env, protocol).obj(), j_appData == nullptr ? j_appDataJson.obj() : j_appData);
       return JavaToNativeString(env, ScopedJavaLocalRef<jstring>(env, static_cast<jstring>(result)));
     },
-    j_listener_.obj(), j_transport_.obj(), sctpStreamParameters, label, protocol, appData);
+    j_listener_.obj(), j_transport_.obj(), sctpStreamParameters, label, protocol, appData, j_pendingAppData_));
 }
 
 inline SendTransport* getSendTransport(jlong j_transport)
@@ -145,11 +213,11 @@ inline SendTransport* getSendTransport(jlong j_transport)
   return reinterpret_cast<OwnedSendTransport*>(j_transport)->sendTransport();
 }
 
-ScopedJavaLocalRef<jobject> NativeToJavaSendTransport(JNIEnv* env, SendTransport* transport, SendTransportListenerJni* listener)
+ScopedJavaLocalRef<jobject> NativeToJavaSendTransport(JNIEnv* env, SendTransport* transport, SendTransportListenerJni* listener, UsageToken usage, AppData appData, bool dataOnly)
 {
   MSC_TRACE();
 
-  auto ownedTransport = new OwnedSendTransport(transport, listener);
+  auto ownedTransport = new OwnedSendTransport(transport, listener, std::move(usage), std::move(appData), dataOnly);
   auto j_transport = ScopedJavaLocalRef<jobject>(env, env->NewObject(sendTransportClass, sendTransportConstructorMethod, NativeToJavaPointer(ownedTransport)));
   listener->SetJTransport(env, j_transport);
   return j_transport;
@@ -41,16 +41,22 @@ public:
 
 public:
   void SetJTransport(JNIEnv* env, const JavaRef<jobject>& j_transport) { j_transport_ = j_transport; }
+  // Opaque appData of the produce call in progress, a global reference owned by the caller.
+  void SetPendingAppData(jstring j_appData) { j_pendingAppData_ = j_appData; }
 
 private:
   const ScopedJavaGlobalRef<jobject> j_listener_;
   ScopedJavaGlobalRef<jobject> j_transport_;
+  jstring j_pendingAppData_{ nullptr };
 };
 
 class OwnedSendTransport final : public OwnedTransport
 {
 public:
-  OwnedSendTransport(SendTransport* transport, SendTransportListenerJni* listener) : transport_(transport), listener_(listener) {}
+  OwnedSendTransport(SendTransport* transport, SendTransportListenerJni* listener, UsageToken usage, AppData appData, bool dataOnly)
+    : OwnedTransport(std::move(usage), std::move(appData), dataOnly), transport_(transport), listener_(listener)
+  {
+  }
 
   ~OwnedSendTransport()
   {
@@ -60,6 +66,7 @@ public:
 
   Transport* transport() const override { return transport_; }
   SendTransport* sendTransport() const { return transport_; }
+  SendTransportListenerJni* listener() const { return listener_; }
 
 private:
   SendTransport* transport_;
@@ -68,7 +75,7 @@ private:
 
 inline SendTransport* getSendTransport(jlong j_transport);
 
-ScopedJavaLocalRef<jobject> NativeToJavaSendTransport(JNIEnv* env, SendTransport* transport, SendTransportListenerJni* listener);
+ScopedJavaLocalRef<jobject> NativeToJavaSendTransport(JNIEnv* env, SendTransport* transport, SendTransportListenerJni* listener, UsageToken usage, AppData appData, bool dataOnly);
 
 } // namespace mediasoupclient
 
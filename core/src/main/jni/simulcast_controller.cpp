@@ -0,0 +1,295 @@
+#define MSC_CLASS "simulcast_controller"
+
+#include "simulcast_controller.h"
+
+#include <Logger.hpp>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#include "json_parser.h"
+#include "producer.h"
+
+namespace mediasoupclient
+{
+
+namespace
+{
+
+int64_t steadyMillis()
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+extern "C"
+{
+
+  JNI_DEFINE_METHOD(jlong, Producer, nativeCreateSimulcastController, jlong j_producer, jint j_intervalMs, jdouble j_headroom, jint j_downSamples, jint j_upSamples)
+  {
+    MSC_TRACE();
+
+    return handleNativeCrash(env,
+                             [&]() {
+                               if (j_intervalMs <= 0 || j_headroom <= 0 || j_downSamples <= 0 || j_upSamples <= 0)
+                               {
+                                 throw std::invalid_argument("invalid simulcast controller settings");
+                               }
+                               SimulcastController::Settings settings{ j_intervalMs, j_headroom, j_downSamples, j_upSamples };
+                               auto* ownedProducer = reinterpret_cast<OwnedProducer*>(j_producer);
+                               auto* result = new OwnedSimulcastController{ std::make_shared<SimulcastController>(ownedProducer->producer(), ownedProducer->transportMutex(),
+                                                                                                                  ownedProducer->rtpParameters(), settings) };
+                               ownedProducer->setSimulcastController(result->controller);
+                               return NativeToJavaPointer(result);
+                             })
+      .value_or(0L);
+  }
+
+  JNI_DEFINE_METHOD(jstring, SimulcastController, nativeGetMetrics, jlong j_controller)
+  {
+    MSC_TRACE();
+
+    return handleNativeCrash(env,
+                             [&]() {
+                               auto result = reinterpret_cast<OwnedSimulcastController*>(j_controller)->controller->metrics();
+                               return NativeToJavaJson(env, result).Release();
+                             })
+      .value_or(nullptr);
+  }
+
+  JNI_DEFINE_METHOD(void, SimulcastController, nativeDispose, jlong j_controller)
+  {
+    MSC_TRACE();
+
+    delete reinterpret_cast<OwnedSimulcastController*>(j_controller);
+  }
+}
+
+SimulcastController::SimulcastController(Producer* producer, std::shared_ptr<std::recursive_mutex> transportMutex, const rtp::Parameters& rtpParameters, const Settings& settings)
+  : producer_(producer), transportMutex_(std::move(transportMutex)), settings_(settings)
+{
+  MSC_TRACE();
+
+  if (producer_->GetKind() != "video")
+  {
+    throw std::invalid_argument("not a video producer");
+  }
+
+  const auto& encodings = rtpParameters.encodings;
+  if (encodings.size() < 2)
+  {
+    throw std::invalid_argument("producer has a single encoding");
+  }
+  layers_ = static_cast<int>(encodings.size());
+  // The producer sends every layer until a max spatial layer is set; GetMaxSpatialLayer() is 0 until then.
+  layer_ = layers_ - 1;
+  setCumulativeBitrates(rtpParameters);
+
+  thread_ = std::thread([this]() { run(); });
+}
+
+SimulcastController::~SimulcastController()
+{
+  MSC_TRACE();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  stopped_.notify_all();
+  thread_.join();
+}
+
+void SimulcastController::updateEncodings(const rtp::Parameters& rtpParameters)
+{
+  MSC_TRACE();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  setCumulativeBitrates(rtpParameters);
+}
+
+void SimulcastController::setCumulativeBitrates(const rtp::Parameters& rtpParameters)
+{
+  cumulativeBitrates_.clear();
+  double sum = 0;
+  for (const auto& encoding : rtpParameters.encodings)
+  {
+    if (!encoding.maxBitrate)
+    {
+      cumulativeBitrates_.clear();
+      return;
+    }
+    sum += *encoding.maxBitrate;
+    cumulativeBitrates_.push_back(sum);
+  }
+}
+
+json SimulcastController::metrics()
+{
+  MSC_TRACE();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto decisions = json::array();
+  for (const auto& decision : decisions_)
+  {
+    json entry = { { "timeMs", decision.timeMs }, { "from", decision.from }, { "to", decision.to }, { "reason", decision.reason } };
+    if (decision.availableBitrate)
+    {
+      entry["availableOutgoingBitrate"] = *decision.availableBitrate;
+    }
+    decisions.push_back(std::move(entry));
+  }
+
+  return {
+    { "maxSpatialLayer", layer_ },
+    { "reason", lastReason_ },
+    { "raises", raises_ },
+    { "lowers", lowers_ },
+    { "decisions", std::move(decisions) },
+  };
+}
+
+void SimulcastController::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopped_.wait_for(lock, std::chrono::milliseconds(settings_.intervalMs), [this]() { return stop_; }))
+  {
+    // Stats and SetMaxSpatialLayer() block on the signaling thread.
+    lock.unlock();
+    try
+    {
+      // A busy transport skips the sample rather than wait, so that disposing the controller within a transport operation cannot deadlock.
+      std::unique_lock<std::recursive_mutex> transportLock(*transportMutex_, std::try_to_lock);
+      if (transportLock.owns_lock() && !producer_->IsClosed())
+      {
+        step();
+      }
+    }
+    catch (const std::exception& e)
+    {
+      MSC_WARN("simulcast controller step failed: %s", e.what());
+    }
+    lock.lock();
+  }
+}
+
+void SimulcastController::step()
+{
+  auto sample = parseStats(producer_->GetStats());
+
+  int current;
+  int target;
+  std::string reason;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    current = layer_;
+    target = targetLayer(sample, current, reason);
+  }
+  if (target == current)
+  {
+    pendingCount_ = 0;
+    return;
+  }
+
+  // Count samples asking for the same direction.
+  auto direction = target < current ? -1 : 1;
+  auto pendingDirection = pendingTarget_ < 0 ? 0 : (pendingTarget_ < current ? -1 : 1);
+  pendingCount_ = direction == pendingDirection ? pendingCount_ + 1 : 1;
+  pendingTarget_ = target;
+
+  if (pendingCount_ < (direction < 0 ? settings_.downSamples : settings_.upSamples))
+  {
+    return;
+  }
+
+  auto next = direction < 0 ? target : current + 1;
+  if (producer_->GetMaxSpatialLayer() == next)
+  {
+    // Producer skips the layer it last recorded, 0 before the first call, even though every layer is sent.
+    producer_->SetMaxSpatialLayer(static_cast<uint8_t>(current));
+  }
+  producer_->SetMaxSpatialLayer(static_cast<uint8_t>(next));
+  pendingCount_ = 0;
+  pendingTarget_ = -1;
+
+  MSC_DEBUG("max spatial layer %d -> %d (%s)", current, next, reason.c_str());
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  layer_ = next;
+  lastReason_ = reason;
+  (direction < 0 ? lowers_ : raises_)++;
+  decisions_.push_back({ steadyMillis(), current, next, reason, sample.availableBitrate });
+  if (decisions_.size() > kMaxDecisions)
+  {
+    decisions_.pop_front();
+  }
+}
+
+SimulcastController::Sample SimulcastController::parseStats(const json& stats)
+{
+  Sample sample;
+  auto visit = [&sample](const json& entry) {
+    if (!entry.is_object())
+    {
+      return;
+    }
+    auto type = entry.value("type", "");
+    if (type == "candidate-pair" && entry.value("nominated", false))
+    {
+      auto bitrate = entry.find("availableOutgoingBitrate");
+      if (bitrate != entry.end() && bitrate->is_number())
+      {
+        sample.availableBitrate = bitrate->get<double>();
+      }
+    }
+    else if (type == "outbound-rtp")
+    {
+      // Any layer limited by cpu limits all of them, as they share the encoder.
+      auto reason = entry.value("qualityLimitationReason", "none");
+      if (reason != "none" && sample.qualityLimitationReason != "cpu")
+      {
+        sample.qualityLimitationReason = reason;
+      }
+    }
+  };
+
+  if (stats.is_array())
+  {
+    std::for_each(stats.begin(), stats.end(), visit);
+  }
+  else if (stats.is_object())
+  {
+    for (const auto& item : stats.items())
+    {
+      visit(item.value());
+    }
+  }
+  return sample;
+}
+
+int SimulcastController::targetLayer(const Sample& sample, int current, std::string& reason) const
+{
+  auto target = layers_ - 1;
+  reason = "none";
+
+  if (sample.availableBitrate && !cumulativeBitrates_.empty())
+  {
+    auto budget = *sample.availableBitrate * settings_.headroom;
+    auto fitting = static_cast<int>(std::upper_bound(cumulativeBitrates_.begin(), cumulativeBitrates_.end(), budget) - cumulativeBitrates_.begin()) - 1;
+    if (fitting < target)
+    {
+      target = std::max(fitting, 0);
+      reason = "bandwidth";
+    }
+  }
+
+  if (sample.qualityLimitationReason == "cpu" && current - 1 < target)
+  {
+    target = std::max(current - 1, 0);
+    reason = "cpu";
+  }
+  return target;
+}
+
+} // namespace mediasoupclient
@@ -0,0 +1,117 @@
+#ifndef SIMULCAST_CONTROLLER_H_
+#define SIMULCAST_CONTROLLER_H_
+
+#include <jni.h>
+
+#include <Producer.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "jni_common.h"
+#include "jni_util.h"
+#include "rtp_parameters.h"
+
+namespace mediasoupclient
+{
+
+extern "C"
+{
+
+  JNI_DEFINE_METHOD(jlong, Producer, nativeCreateSimulcastController, jlong j_producer, jint j_intervalMs, jdouble j_headroom, jint j_downSamples, jint j_upSamples);
+
+  JNI_DEFINE_METHOD(jstring, SimulcastController, nativeGetMetrics, jlong j_controller);
+
+  JNI_DEFINE_METHOD(void, SimulcastController, nativeDispose, jlong j_controller);
+}
+
+// Drives Producer::SetMaxSpatialLayer() from the sender stats.
+// The layers whose summed maxBitrate fits in the available outgoing bitrate are kept, and one more is dropped
+// while the encoder is CPU limited. Lowering needs |downSamples| samples in a row, raising |upSamples|
+// and goes one layer at a time. Samples are taken under the transport lock and skipped while it is busy.
+class SimulcastController final
+{
+public:
+  struct Settings
+  {
+    int intervalMs;
+    // Share of the available outgoing bitrate the layers may use.
+    double headroom;
+    int downSamples;
+    int upSamples;
+  };
+
+  SimulcastController(Producer* producer, std::shared_ptr<std::recursive_mutex> transportMutex, const rtp::Parameters& rtpParameters, const Settings& settings);
+  ~SimulcastController();
+
+  SimulcastController(const SimulcastController&) = delete;
+  SimulcastController& operator=(const SimulcastController&) = delete;
+
+  json metrics();
+  // Takes the maxBitrate of the layers again, after setEncodings().
+  void updateEncodings(const rtp::Parameters& rtpParameters);
+
+private:
+  struct Sample
+  {
+    std::optional<double> availableBitrate;
+    std::string qualityLimitationReason;
+  };
+
+  struct Decision
+  {
+    int64_t timeMs;
+    int from;
+    int to;
+    std::string reason;
+    std::optional<double> availableBitrate;
+  };
+
+  static constexpr size_t kMaxDecisions = 32;
+
+  void run();
+  void step();
+  static Sample parseStats(const json& stats);
+  void setCumulativeBitrates(const rtp::Parameters& rtpParameters);
+  // Highest layer the sample allows.
+  int targetLayer(const Sample& sample, int current, std::string& reason) const;
+
+  Producer* const producer_;
+  const std::shared_ptr<std::recursive_mutex> transportMutex_;
+  const Settings settings_;
+  int layers_{ 0 };
+
+  std::mutex mutex_;
+  // Sum of the maxBitrate of the layers up to each one, empty when they are not all set.
+  std::vector<double> cumulativeBitrates_;
+  std::condition_variable stopped_;
+  bool stop_{ false };
+  std::deque<Decision> decisions_;
+  uint64_t raises_{ 0 };
+  uint64_t lowers_{ 0 };
+  // Layer last set by the controller, all of them at start.
+  int layer_{ 0 };
+  std::string lastReason_;
+
+  // Controller thread only.
+  int pendingTarget_{ -1 };
+  int pendingCount_{ 0 };
+
+  std::thread thread_;
+};
+
+struct OwnedSimulcastController
+{
+  std::shared_ptr<SimulcastController> controller;
+};
+
+} // namespace mediasoupclient
+
+#endif // SIMULCAST_CONTROLLER_H_
@@ -0,0 +1,124 @@
+#define MSC_CLASS "thread_policy"
+
+#include "thread_policy.h"
+
+#include <sdk/android/src/jni/pc/owned_factory_and_threads.h>
+
+#include <Logger.hpp>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <sched.h>
+#include <stdexcept>
+#include <sys/resource.h>
+#include <unistd.h>
+
+using namespace webrtc;
+
+namespace mediasoupclient
+{
+
+namespace
+{
+
+// Must match ThreadPolicy.Target.
+constexpr jint kNetworkThread = 0;
+constexpr jint kWorkerThread = 1;
+constexpr jint kSignalingThread = 2;
+
+// ThreadPolicy.niceValue is null.
+constexpr jint kKeepNiceValue = INT_MIN;
+
+rtc::Thread* getFactoryThread(jni::OwnedFactoryAndThreads* owned, jint j_target)
+{
+  switch (j_target)
+  {
+    case kNetworkThread:
+      return owned->network_thread();
+    case kWorkerThread:
+      return owned->worker_thread();
+    case kSignalingThread:
+      return owned->signaling_thread();
+    default:
+      throw std::invalid_argument("unknown thread");
+  }
+}
+
+// Runs on the target thread: with pid 0 / the own tid these calls only affect the calling thread.
+bool applyToCurrentThread(uint64_t cpuAffinity, jint niceValue, jint realtimePriority)
+{
+  bool applied = true;
+
+  if (cpuAffinity != 0)
+  {
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (int cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; ++cpu)
+    {
+      if ((cpuAffinity >> cpu) & 1)
+      {
+        CPU_SET(cpu, &cpuSet);
+      }
+    }
+    if (sched_setaffinity(0, sizeof(cpuSet), &cpuSet) != 0)
+    {
+      MSC_WARN("sched_setaffinity() failed [mask:0x%llx, error:%s]", static_cast<unsigned long long>(cpuAffinity), std::strerror(errno));
+      applied = false;
+    }
+  }
+
+  if (niceValue != kKeepNiceValue && setpriority(PRIO_PROCESS, static_cast<id_t>(gettid()), niceValue) != 0)
+  {
+    MSC_WARN("setpriority() failed [nice:%d, error:%s]", niceValue, std::strerror(errno));
+    applied = false;
+  }
+
+  if (realtimePriority > 0)
+  {
+    sched_param param{};
+    param.sched_priority = realtimePriority;
+    if (sched_setscheduler(0, SCHED_FIFO, &param) != 0)
+    {
+      MSC_WARN("sched_setscheduler(SCHED_FIFO) failed [priority:%d, error:%s]", realtimePriority, std::strerror(errno));
+      applied = false;
+    }
+  }
+
+  return applied;
+}
+
+} // namespace
+
+extern "C"
+{
+
+  JNI_DEFINE_METHOD(jboolean, ThreadPolicy, nativeApply, jlong j_ownedFactory, jint j_target, jlong j_cpuAffinity, jint j_niceValue, jint j_realtimePriority)
+  {
+    MSC_TRACE();
+
+    return handleNativeCrash(env,
+                             [&]() {
+                               auto* thread = getFactoryThread(reinterpret_cast<jni::OwnedFactoryAndThreads*>(j_ownedFactory), j_target);
+                               auto result = thread->BlockingCall([&]() { return applyToCurrentThread(static_cast<uint64_t>(j_cpuAffinity), j_niceValue, j_realtimePriority); });
+                               return static_cast<jboolean>(result);
+                             })
+      .value_or(false);
+  }
+
+  JNI_DEFINE_METHOD(jlong, ThreadPolicy, nativeMeasureQueueDelay, jlong j_ownedFactory, jint j_target)
+  {
+    MSC_TRACE();
+
+    return handleNativeCrash(env,
+                             [&]() {
+                               auto* thread = getFactoryThread(reinterpret_cast<jni::OwnedFactoryAndThreads*>(j_ownedFactory), j_target);
+                               auto posted = std::chrono::steady_clock::now();
+                               auto result = thread->BlockingCall([&]() { return std::chrono::steady_clock::now() - posted; });
+                               return static_cast<jlong>(std::chrono::duration_cast<std::chrono::microseconds>(result).count());
+                             })
+      .value_or(-1L);
+  }
+}
+
+} // namespace mediasoupclient
@@ -0,0 +1,22 @@
+#ifndef THREAD_POLICY_H_
+#define THREAD_POLICY_H_
+
+#include <jni.h>
+
+#include "jni_common.h"
+#include "jni_util.h"
+
+namespace mediasoupclient
+{
+
+extern "C"
+{
+
+  JNI_DEFINE_METHOD(jboolean, ThreadPolicy, nativeApply, jlong j_ownedFactory, jint j_target, jlong j_cpuAffinity, jint j_niceValue, jint j_realtimePriority);
+
+  JNI_DEFINE_METHOD(jlong, ThreadPolicy, nativeMeasureQueueDelay, jlong j_ownedFactory, jint j_target);
+}
+
+} // namespace mediasoupclient
+
+#endif // THREAD_POLICY_H_
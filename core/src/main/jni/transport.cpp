@@ -9,6 +9,10 @@
 #include <Transport.hpp>
 #include <json.hpp>
 
+#include "json_parser.h"
+#include "negotiation_scope.h"
+#include "transport_lock.h"
+
 using namespace webrtc;
 
 namespace mediasoupclient
@@ -59,8 +63,12 @@ extern "C"
 
     return handleNativeCrash(env,
                              [&]() {
+                               if (const auto& appData = getOwnedTransport(j_transport)->appData(); appData.opaque())
+                               {
+                                 return appData.toJava(env).Release();
+                               }
                                auto result = getTransport(j_transport)->GetAppData();
-                               return NativeToJavaString(env, result.dump()).Release();
+                               return NativeToJavaJson(env, result).Release();
                              })
       .value_or(nullptr);
   }
@@ -69,7 +77,15 @@ extern "C"
   {
     MSC_TRACE();
 
-    handleNativeCrashNoReturn(env, [&]() { getTransport(j_transport)->Close(); });
+    handleNativeCrashNoReturn(env, [&]() {
+      auto* ownedTransport = getOwnedTransport(j_transport);
+      TransportLock lock(*ownedTransport->mutex());
+      getTransport(j_transport)->Close();
+#ifdef MSC_FAST_SDP
+      // Nothing is written for a closed transport anymore.
+      ownedTransport->writeCache().clear();
+#endif
+    });
   }
 
   JNI_DEFINE_METHOD(jstring, Transport, nativeGetStats, jlong j_transport)
@@ -78,8 +94,9 @@ extern "C"
 
     return handleNativeCrash(env,
                              [&]() {
+                               TransportLock lock(*getOwnedTransport(j_transport)->mutex());
                                auto result = getTransport(j_transport)->GetStats();
-                               return NativeToJavaString(env, result.dump()).Release();
+                               return NativeToJavaJson(env, result).Release();
                              })
       .value_or(nullptr);
   }
@@ -88,12 +105,17 @@ extern "C"
   {
     MSC_TRACE();
 
+    NegotiationScope scope("Transport.restartIce", getOwnedTransport(j_transport)->usage().get());
+
     handleNativeCrashNoReturn(env, [&]() {
       auto iceParameters = json::object();
       if (j_iceParameters != nullptr)
       {
-        iceParameters = json::parse(JavaToNativeString(env, JavaParamRef<jstring>(env, j_iceParameters)));
+        iceParameters = JavaToNativeJson(env, JavaParamRef<jstring>(env, j_iceParameters));
       }
+      auto* ownedTransport = getOwnedTransport(j_transport);
+      TransportLock lock(*ownedTransport->mutex());
+      SdpWriteScope sdpWrite(*ownedTransport);
       getTransport(j_transport)->RestartIce(iceParameters);
     });
   }
@@ -102,12 +124,15 @@ extern "C"
   {
     MSC_TRACE();
 
+    NegotiationScope scope("Transport.updateIceServers", getOwnedTransport(j_transport)->usage().get());
+
     handleNativeCrashNoReturn(env, [&]() {
       auto iceServers = json::object();
       if (j_iceServers != nullptr)
       {
-        iceServers = json::parse(JavaToNativeString(env, JavaParamRef<jstring>(env, j_iceServers)));
+        iceServers = JavaToNativeJson(env, JavaParamRef<jstring>(env, j_iceServers));
       }
+      TransportLock lock(*getOwnedTransport(j_transport)->mutex());
       getTransport(j_transport)->UpdateIceServers(iceServers);
     });
   }
@@ -125,4 +150,9 @@ inline Transport* getTransport(jlong j_transport)
   return reinterpret_cast<OwnedTransport*>(j_transport)->transport();
 }
 
+OwnedTransport* getOwnedTransport(jlong j_transport)
+{
+  return reinterpret_cast<OwnedTransport*>(j_transport);
+}
+
 } // namespace mediasoupclient
\ No newline at end of file
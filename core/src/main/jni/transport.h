@@ -5,9 +5,16 @@
 #include <sdk/android/native_api/jni/scoped_java_ref.h>
 
 #include <Transport.hpp>
+#include <memory>
+#include <mutex>
 
+#include "app_data.h"
+#include "device_usage.h"
 #include "jni_common.h"
 #include "jni_util.h"
+#ifdef MSC_FAST_SDP
+#include "sdp_transform.h"
+#endif
 
 namespace mediasoupclient
 {
@@ -29,17 +36,63 @@ extern "C"
   JNI_DEFINE_METHOD(void, Transport, nativeRestartIce, jlong j_transport, jstring j_iceParameters);
 
   JNI_DEFINE_METHOD(void, Transport, nativeUpdateIceServers, jlong j_transport, jstring j_iceServers);
+
+  JNI_DEFINE_METHOD(void, Transport, nativeDispose, jlong j_transport);
 }
 
 class OwnedTransport
 {
 public:
+  OwnedTransport(UsageToken usage, AppData appData, bool dataOnly) : usage_(std::move(usage)), appData_(std::move(appData)), dataOnly_(dataOnly) {}
   virtual ~OwnedTransport() = default;
   virtual Transport* transport() const = 0;
+
+  const std::shared_ptr<DeviceUsage>& usage() const { return usage_.usage(); }
+  // Also tells whether producers and consumers of this transport keep their appData opaque.
+  const AppData& appData() const { return appData_; }
+  // Created by a data-only Device, produce and consume are rejected.
+  bool dataOnly() const { return dataOnly_; }
+  // libmediasoupclient does not serialize the operations of a transport, so the bridge holds this around each of them
+  // with a TransportLock, and releases it while Produce and ProduceData wait for the app.
+  // Recursive, as listeners called within an operation may close producers and consumers of the same transport.
+  const std::shared_ptr<std::recursive_mutex>& mutex() const { return mutex_; }
+#ifdef MSC_FAST_SDP
+  // Media sections of the SDPs written for this transport, see SdpWriteScope.
+  sdptransform::WriteCache& writeCache() const { return *writeCache_; }
+#endif
+
+private:
+  UsageToken usage_;
+  AppData appData_;
+  const bool dataOnly_;
+  const std::shared_ptr<std::recursive_mutex> mutex_ = std::make_shared<std::recursive_mutex>();
+#ifdef MSC_FAST_SDP
+  const std::unique_ptr<sdptransform::WriteCache> writeCache_ = std::make_unique<sdptransform::WriteCache>();
+#endif
+};
+
+// Lets the SDP writes of an operation on |transport| reuse the media sections written by its previous operations.
+// Does nothing unless built with MSC_FAST_SDP.
+class SdpWriteScope final
+{
+public:
+  explicit SdpWriteScope([[maybe_unused]] const OwnedTransport& transport)
+#ifdef MSC_FAST_SDP
+    : scope_(transport.writeCache())
+#endif
+  {
+  }
+
+private:
+#ifdef MSC_FAST_SDP
+  sdptransform::WriteCacheScope scope_;
+#endif
 };
 
 inline Transport* getTransport(jlong j_transport);
 
+OwnedTransport* getOwnedTransport(jlong j_transport);
+
 } // namespace mediasoupclient
 
 #endif // TRANSPORT_H_
\ No newline at end of file
@@ -0,0 +1,57 @@
+#define MSC_CLASS "transport_lock"
+
+#include "transport_lock.h"
+
+#include <vector>
+
+namespace mediasoupclient
+{
+
+namespace
+{
+
+thread_local TransportLock* innermostLock = nullptr;
+
+} // namespace
+
+TransportLock::TransportLock(std::recursive_mutex& mutex) : mutex_(mutex)
+{
+  mutex_.lock();
+  outer_ = innermostLock;
+  innermostLock = this;
+}
+
+TransportLock::~TransportLock()
+{
+  innermostLock = outer_;
+  mutex_.unlock();
+}
+
+TransportLock* TransportLock::current()
+{
+  return innermostLock;
+}
+
+TransportLock::Released::Released(TransportLock* locks) : locks_(locks)
+{
+  for (auto* lock = locks_; lock != nullptr; lock = lock->outer_)
+  {
+    lock->mutex_.unlock();
+  }
+}
+
+TransportLock::Released::~Released()
+{
+  // Outermost first, in the order they were taken.
+  std::vector<TransportLock*> chain;
+  for (auto* lock = locks_; lock != nullptr; lock = lock->outer_)
+  {
+    chain.push_back(lock);
+  }
+  for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+  {
+    (*it)->mutex_.lock();
+  }
+}
+
+} // namespace mediasoupclient
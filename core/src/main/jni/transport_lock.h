@@ -0,0 +1,63 @@
+#ifndef TRANSPORT_LOCK_H_
+#define TRANSPORT_LOCK_H_
+
+#include <future>
+#include <mutex>
+#include <utility>
+
+namespace mediasoupclient
+{
+
+// Holds the mutex of a transport for one operation, see OwnedTransport::mutex().
+// The locks of a thread are chained, so that waiting for the app within an operation can release all of them:
+// onProduce may need the signaling of the app, which may in turn operate on the same transport.
+class TransportLock final
+{
+public:
+  explicit TransportLock(std::recursive_mutex& mutex);
+  ~TransportLock();
+
+  TransportLock(const TransportLock&) = delete;
+  TransportLock& operator=(const TransportLock&) = delete;
+
+  // Future that waits for |future| with the transport locks of the current thread released, and takes them back.
+  // It must be waited for on the current thread within the operation, as libmediasoupclient does with the listener futures.
+  template <typename T>
+  static std::future<T> releasedWhileWaiting(std::future<T> future)
+  {
+    auto* locks = current();
+    if (locks == nullptr)
+    {
+      return future;
+    }
+    return std::async(std::launch::deferred, [future = std::move(future), locks]() mutable {
+      Released released(locks);
+      return future.get();
+    });
+  }
+
+private:
+  // Unlocks |locks| and the ones it is nested in, and locks them again in the same order when destroyed.
+  class Released final
+  {
+  public:
+    explicit Released(TransportLock* locks);
+    ~Released();
+
+    Released(const Released&) = delete;
+    Released& operator=(const Released&) = delete;
+
+  private:
+    TransportLock* locks_;
+  };
+
+  // Innermost lock of the current thread.
+  static TransportLock* current();
+
+  std::recursive_mutex& mutex_;
+  TransportLock* outer_;
+};
+
+} // namespace mediasoupclient
+
+#endif // TRANSPORT_LOCK_H_
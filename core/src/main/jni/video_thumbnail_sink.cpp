@@ -0,0 +1,193 @@
+#define MSC_CLASS "video_thumbnail_sink"
+
+#include "video_thumbnail_sink.h"
+
+#include <libyuv/scale.h>
+#include <sdk/android/src/jni/video_frame.h>
+
+#include <Logger.hpp>
+#include <algorithm>
+#include <ctime>
+#include <stdexcept>
+
+#include "consumer.h"
+
+using namespace webrtc;
+
+namespace mediasoupclient
+{
+
+namespace
+{
+
+int64_t threadCpuTimeNanos()
+{
+  timespec ts{};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+// Largest even size fitting in the bounds while keeping the aspect ratio, never upscaled.
+void fitSize(int width, int height, int maxWidth, int maxHeight, int& outWidth, int& outHeight)
+{
+  auto scale = std::min({ 1.0, static_cast<double>(maxWidth) / width, static_cast<double>(maxHeight) / height });
+  outWidth = std::max(2, static_cast<int>(width * scale) & ~1);
+  outHeight = std::max(2, static_cast<int>(height * scale) & ~1);
+}
+
+} // namespace
+
+extern "C"
+{
+
+  JNI_DEFINE_METHOD(jlong, Consumer, nativeAddThumbnailSink, jlong j_consumer, jint j_maxWidth, jint j_maxHeight, jint j_maxFramerate)
+  {
+    MSC_TRACE();
+
+    return handleNativeCrash(env,
+                             [&]() {
+                               if (j_maxWidth < 2 || j_maxHeight < 2 || j_maxFramerate < 0)
+                               {
+                                 throw std::invalid_argument("invalid thumbnail size");
+                               }
+                               auto* track = reinterpret_cast<OwnedConsumer*>(j_consumer)->consumer()->GetTrack();
+                               if (track->kind() != MediaStreamTrackInterface::kVideoKind)
+                               {
+                                 throw std::invalid_argument("not a video consumer");
+                               }
+                               auto* result = new VideoThumbnailSink(scoped_refptr<VideoTrackInterface>(static_cast<VideoTrackInterface*>(track)), j_maxWidth, j_maxHeight, j_maxFramerate);
+                               return NativeToJavaPointer(result);
+                             })
+      .value_or(0L);
+  }
+
+  JNI_DEFINE_METHOD(jobject, VideoThumbnailSink, nativePoll, jlong j_thumbnailSink)
+  {
+    MSC_TRACE();
+
+    return handleNativeCrash(env,
+                             [&]() -> jobject {
+                               auto frame = reinterpret_cast<VideoThumbnailSink*>(j_thumbnailSink)->poll();
+                               if (!frame)
+                               {
+                                 return nullptr;
+                               }
+                               return jni::NativeToJavaVideoFrame(env, *frame).Release();
+                             })
+      .value_or(nullptr);
+  }
+
+  JNI_DEFINE_METHOD(jlong, VideoThumbnailSink, nativeGetCpuTimeNanos, jlong j_thumbnailSink)
+  {
+    MSC_TRACE();
+
+    return static_cast<jlong>(reinterpret_cast<VideoThumbnailSink*>(j_thumbnailSink)->cpuTimeNanos());
+  }
+
+  JNI_DEFINE_METHOD(jlong, VideoThumbnailSink, nativeGetDeliveredFrames, jlong j_thumbnailSink)
+  {
+    MSC_TRACE();
+
+    return static_cast<jlong>(reinterpret_cast<VideoThumbnailSink*>(j_thumbnailSink)->deliveredFrames());
+  }
+
+  JNI_DEFINE_METHOD(jlong, VideoThumbnailSink, nativeGetDroppedFrames, jlong j_thumbnailSink)
+  {
+    MSC_TRACE();
+
+    return static_cast<jlong>(reinterpret_cast<VideoThumbnailSink*>(j_thumbnailSink)->droppedFrames());
+  }
+
+  JNI_DEFINE_METHOD(void, VideoThumbnailSink, nativeDispose, jlong j_thumbnailSink)
+  {
+    MSC_TRACE();
+
+    delete reinterpret_cast<VideoThumbnailSink*>(j_thumbnailSink);
+  }
+}
+
+VideoThumbnailSink::VideoThumbnailSink(scoped_refptr<VideoTrackInterface> track, int maxWidth, int maxHeight, int maxFramerate)
+  : track_(std::move(track)), maxWidth_(maxWidth), maxHeight_(maxHeight), minIntervalUs_(maxFramerate > 0 ? 1000000 / maxFramerate : 0), pool_(false, kPoolSize)
+{
+  MSC_TRACE();
+
+  rtc::VideoSinkWants wants;
+  if (maxFramerate > 0)
+  {
+    wants.max_framerate_fps = maxFramerate;
+  }
+  track_->AddOrUpdateSink(this, wants);
+}
+
+VideoThumbnailSink::~VideoThumbnailSink()
+{
+  MSC_TRACE();
+
+  // OnFrame() is not called anymore once RemoveSink() returns.
+  track_->RemoveSink(this);
+}
+
+void VideoThumbnailSink::OnFrame(const VideoFrame& frame)
+{
+  auto start = threadCpuTimeNanos();
+  scale(frame);
+  cpuTimeNanos_.fetch_add(threadCpuTimeNanos() - start, std::memory_order_relaxed);
+}
+
+void VideoThumbnailSink::scale(const VideoFrame& frame)
+{
+  auto timestampUs = frame.timestamp_us();
+  if (lastTimestampUs_ && timestampUs - *lastTimestampUs_ < minIntervalUs_)
+  {
+    return;
+  }
+
+  // Texture frames of hardware decoders are converted here, which is the expensive part for them.
+  auto source = frame.video_frame_buffer()->ToI420();
+  if (!source)
+  {
+    droppedFrames_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  int width;
+  int height;
+  fitSize(source->width(), source->height(), maxWidth_, maxHeight_, width, height);
+
+  // Every pooled buffer is still queued or held by the reader.
+  auto buffer = pool_.CreateI420Buffer(width, height);
+  if (!buffer)
+  {
+    droppedFrames_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  libyuv::I420Scale(source->DataY(), source->StrideY(), source->DataU(), source->StrideU(), source->DataV(), source->StrideV(), source->width(), source->height(), buffer->MutableDataY(),
+                    buffer->StrideY(), buffer->MutableDataU(), buffer->StrideU(), buffer->MutableDataV(), buffer->StrideV(), width, height, libyuv::kFilterBox);
+  lastTimestampUs_ = timestampUs;
+
+  auto thumbnail = VideoFrame::Builder().set_video_frame_buffer(buffer).set_timestamp_us(timestampUs).set_rotation(frame.rotation()).build();
+
+  std::lock_guard<std::mutex> lock(latestMutex_);
+  if (latest_)
+  {
+    droppedFrames_.fetch_add(1, std::memory_order_relaxed);
+  }
+  latest_ = std::move(thumbnail);
+}
+
+std::optional<VideoFrame> VideoThumbnailSink::poll()
+{
+  std::optional<VideoFrame> result;
+  {
+    std::lock_guard<std::mutex> lock(latestMutex_);
+    result.swap(latest_);
+  }
+  if (result)
+  {
+    deliveredFrames_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return result;
+}
+
+} // namespace mediasoupclient
@@ -0,0 +1,84 @@
+#ifndef VIDEO_THUMBNAIL_SINK_H_
+#define VIDEO_THUMBNAIL_SINK_H_
+
+#include <jni.h>
+
+#include <api/media_stream_interface.h>
+#include <api/video/i420_buffer.h>
+#include <api/video/video_frame.h>
+#include <common_video/include/video_frame_buffer_pool.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+#include "jni_common.h"
+#include "jni_util.h"
+
+namespace mediasoupclient
+{
+
+extern "C"
+{
+
+  JNI_DEFINE_METHOD(jlong, Consumer, nativeAddThumbnailSink, jlong j_consumer, jint j_maxWidth, jint j_maxHeight, jint j_maxFramerate);
+
+  JNI_DEFINE_METHOD(jobject, VideoThumbnailSink, nativePoll, jlong j_thumbnailSink);
+
+  JNI_DEFINE_METHOD(jlong, VideoThumbnailSink, nativeGetCpuTimeNanos, jlong j_thumbnailSink);
+
+  JNI_DEFINE_METHOD(jlong, VideoThumbnailSink, nativeGetDeliveredFrames, jlong j_thumbnailSink);
+
+  JNI_DEFINE_METHOD(jlong, VideoThumbnailSink, nativeGetDroppedFrames, jlong j_thumbnailSink);
+
+  JNI_DEFINE_METHOD(void, VideoThumbnailSink, nativeDispose, jlong j_thumbnailSink);
+}
+
+// Downscales the frames of a remote video track into pooled I420 buffers.
+// Only the latest thumbnail is kept: frames not polled in time, or arriving while every pooled buffer is
+// still held by the reader, are dropped.
+class VideoThumbnailSink final : public rtc::VideoSinkInterface<webrtc::VideoFrame>
+{
+public:
+  VideoThumbnailSink(webrtc::scoped_refptr<webrtc::VideoTrackInterface> track, int maxWidth, int maxHeight, int maxFramerate);
+  ~VideoThumbnailSink() override;
+
+  VideoThumbnailSink(const VideoThumbnailSink&) = delete;
+  VideoThumbnailSink& operator=(const VideoThumbnailSink&) = delete;
+
+  void OnFrame(const webrtc::VideoFrame& frame) override;
+
+  // Latest thumbnail not returned yet.
+  std::optional<webrtc::VideoFrame> poll();
+
+  // CPU time spent in OnFrame().
+  int64_t cpuTimeNanos() const { return cpuTimeNanos_.load(std::memory_order_relaxed); }
+  uint64_t deliveredFrames() const { return deliveredFrames_.load(std::memory_order_relaxed); }
+  uint64_t droppedFrames() const { return droppedFrames_.load(std::memory_order_relaxed); }
+
+private:
+  static constexpr size_t kPoolSize = 3;
+
+  void scale(const webrtc::VideoFrame& frame);
+
+  const webrtc::scoped_refptr<webrtc::VideoTrackInterface> track_;
+  const int maxWidth_;
+  const int maxHeight_;
+  const int64_t minIntervalUs_;
+
+  std::atomic<int64_t> cpuTimeNanos_{ 0 };
+  std::atomic<uint64_t> deliveredFrames_{ 0 };
+  std::atomic<uint64_t> droppedFrames_{ 0 };
+
+  // Decoder thread only.
+  webrtc::VideoFrameBufferPool pool_;
+  std::optional<int64_t> lastTimestampUs_;
+
+  std::mutex latestMutex_;
+  std::optional<webrtc::VideoFrame> latest_;
+};
+
+} // namespace mediasoupclient
+
+#endif // VIDEO_THUMBNAIL_SINK_H_
@@ -0,0 +1,326 @@
+#define MSC_CLASS "visibility_scheduler"
+
+#include "visibility_scheduler.h"
+
+#include <sdk/android/native_api/jni/java_types.h>
+
+#include <Logger.hpp>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#include "consumer.h"
+#include "json_parser.h"
+#include "recv_transport.h"
+
+using namespace webrtc;
+
+namespace mediasoupclient
+{
+
+extern jmethodID visibilitySchedulerListenerOnScheduleMethod;
+
+namespace
+{
+
+// Reports keep coming while the user scrolls, so a batch is forced after this many debounce periods.
+constexpr int kMaxDebounceCount = 4;
+
+int64_t steadyMillis()
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+extern "C"
+{
+
+  JNI_DEFINE_METHOD(jlong, RecvTransport, nativeCreateVisibilityScheduler, jlong j_transport, jobject j_listener, jint j_debounceMs, jintArray j_layerHeights)
+  {
+    MSC_TRACE();
+
+    return handleNativeCrash(env,
+                             [&]() {
+                               if (j_debounceMs < 0)
+                               {
+                                 throw std::invalid_argument("debounceMs must not be negative");
+                               }
+                               std::vector<int> layerHeights(env->GetArrayLength(j_layerHeights));
+                               static_assert(sizeof(jint) == sizeof(int));
+                               env->GetIntArrayRegion(j_layerHeights, 0, static_cast<jsize>(layerHeights.size()), reinterpret_cast<jint*>(layerHeights.data()));
+                               auto* result = new VisibilityScheduler(env, JavaParamRef<jobject>(env, j_listener), j_debounceMs, std::move(layerHeights));
+                               return NativeToJavaPointer(result);
+                             })
+      .value_or(0L);
+  }
+
+  JNI_DEFINE_METHOD(void, VisibilityScheduler, nativeSetVisibility, jlong j_scheduler, jlong j_consumer, jboolean j_visible, jint j_width, jint j_height)
+  {
+    MSC_TRACE();
+
+    handleNativeCrashNoReturn(env, [&]() {
+      auto* ownedConsumer = reinterpret_cast<OwnedConsumer*>(j_consumer);
+      auto* consumer = ownedConsumer->consumer();
+      if (consumer->GetKind() != MediaStreamTrackInterface::kVideoKind)
+      {
+        throw std::invalid_argument("not a video consumer");
+      }
+      reinterpret_cast<VisibilityScheduler*>(j_scheduler)
+        ->setVisibility(consumer->GetId(), scoped_refptr<MediaStreamTrackInterface>(consumer->GetTrack()), ownedConsumer->rtpParameters().spatialLayers(), j_visible && j_width > 0 && j_height > 0,
+                        j_height);
+    });
+  }
+
+  JNI_DEFINE_METHOD(void, VisibilityScheduler, nativeRemove, jlong j_scheduler, jlong j_consumer)
+  {
+    MSC_TRACE();
+
+    handleNativeCrashNoReturn(env, [&]() { reinterpret_cast<VisibilityScheduler*>(j_scheduler)->remove(reinterpret_cast<OwnedConsumer*>(j_consumer)->consumer()->GetId()); });
+  }
+
+  JNI_DEFINE_METHOD(jstring, VisibilityScheduler, nativeGetMetrics, jlong j_scheduler)
+  {
+    MSC_TRACE();
+
+    return handleNativeCrash(env,
+                             [&]() {
+                               auto result = reinterpret_cast<VisibilityScheduler*>(j_scheduler)->metrics();
+                               return NativeToJavaJson(env, result).Release();
+                             })
+      .value_or(nullptr);
+  }
+
+  JNI_DEFINE_METHOD(void, VisibilityScheduler, nativeDispose, jlong j_scheduler)
+  {
+    MSC_TRACE();
+
+    delete reinterpret_cast<VisibilityScheduler*>(j_scheduler);
+  }
+}
+
+VisibilityScheduler::VisibilityScheduler(JNIEnv* env, const JavaRef<jobject>& j_listener, int debounceMs, std::vector<int> layerHeights)
+  : j_listener_(env, j_listener), debounceMs_(debounceMs), layerHeights_(std::move(layerHeights))
+{
+  MSC_TRACE();
+
+  thread_ = std::thread([this]() { run(); });
+}
+
+VisibilityScheduler::~VisibilityScheduler()
+{
+  MSC_TRACE();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  changed_.notify_all();
+  thread_.join();
+}
+
+void VisibilityScheduler::setVisibility(const std::string& consumerId, scoped_refptr<MediaStreamTrackInterface> track, int spatialLayers, bool visible, int height)
+{
+  MSC_TRACE();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& tile = tiles_[consumerId];
+  if (!tile.track)
+  {
+    tile.track = std::move(track);
+    tile.spatialLayers = spatialLayers;
+  }
+  tile.visible = visible;
+  tile.height = height;
+
+  auto now = steadyMillis();
+  if (!pending_)
+  {
+    pending_ = true;
+    firstPendingMs_ = now;
+  }
+  lastPendingMs_ = now;
+  changed_.notify_all();
+}
+
+void VisibilityScheduler::remove(const std::string& consumerId)
+{
+  MSC_TRACE();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = tiles_.find(consumerId);
+  if (it == tiles_.end())
+  {
+    return;
+  }
+  auto now = steadyMillis();
+  const auto& tile = it->second;
+  if (tile.applied.paused)
+  {
+    pausedMs_ += now - tile.pausedSinceMs;
+  }
+  else if (tile.applied.spatialLayer >= 0 && tile.applied.spatialLayer < tile.spatialLayers - 1)
+  {
+    cappedMs_ += now - tile.cappedSinceMs;
+  }
+  tiles_.erase(it);
+}
+
+json VisibilityScheduler::metrics()
+{
+  MSC_TRACE();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto now = steadyMillis();
+  auto pausedMs = pausedMs_;
+  auto cappedMs = cappedMs_;
+  size_t pausedTiles = 0;
+  for (const auto& [consumerId, tile] : tiles_)
+  {
+    if (tile.applied.paused)
+    {
+      ++pausedTiles;
+      pausedMs += now - tile.pausedSinceMs;
+    }
+    else if (tile.applied.spatialLayer >= 0 && tile.applied.spatialLayer < tile.spatialLayers - 1)
+    {
+      cappedMs += now - tile.cappedSinceMs;
+    }
+  }
+
+  return {
+    { "consumers", tiles_.size() },
+    { "pausedConsumers", pausedTiles },
+    { "batches", batches_ },
+    { "changes", changes_ },
+    { "pausedMillis", pausedMs },
+    { "cappedMillis", cappedMs },
+  };
+}
+
+void VisibilityScheduler::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stop_)
+  {
+    if (!pending_)
+    {
+      changed_.wait(lock);
+      continue;
+    }
+
+    // Wait until the reports have been quiet for a debounce period.
+    auto now = steadyMillis();
+    auto due = std::min(lastPendingMs_ + debounceMs_, firstPendingMs_ + kMaxDebounceCount * debounceMs_);
+    if (now < due)
+    {
+      changed_.wait_for(lock, std::chrono::milliseconds(due - now));
+      continue;
+    }
+
+    pending_ = false;
+    std::vector<std::pair<scoped_refptr<MediaStreamTrackInterface>, bool>> enables;
+    auto changes = apply(now, enables);
+    if (changes.empty())
+    {
+      continue;
+    }
+
+    // Tracks block on the signaling thread and the listener may report again, so neither runs under the lock.
+    lock.unlock();
+    for (auto& [track, enabled] : enables)
+    {
+      track->set_enabled(enabled);
+    }
+    notify(changes);
+    lock.lock();
+  }
+}
+
+VisibilityScheduler::Decision VisibilityScheduler::decide(const Tile& tile) const
+{
+  if (!tile.visible)
+  {
+    return { true, -1 };
+  }
+
+  // Smallest layer at least as tall as the tile.
+  auto layer = tile.spatialLayers - 1;
+  for (int i = 0; i < layer && i < static_cast<int>(layerHeights_.size()); ++i)
+  {
+    if (layerHeights_[i] >= tile.height)
+    {
+      layer = i;
+      break;
+    }
+  }
+  return { false, layer };
+}
+
+json VisibilityScheduler::apply(int64_t nowMs, std::vector<std::pair<scoped_refptr<MediaStreamTrackInterface>, bool>>& enables)
+{
+  auto changes = json::array();
+  for (auto& [consumerId, tile] : tiles_)
+  {
+    auto decision = decide(tile);
+    if (decision == tile.applied)
+    {
+      continue;
+    }
+
+    auto isCapped = [&tile](const Decision& d) { return !d.paused && d.spatialLayer >= 0 && d.spatialLayer < tile.spatialLayers - 1; };
+    if (isCapped(tile.applied) && !isCapped(decision))
+    {
+      cappedMs_ += nowMs - tile.cappedSinceMs;
+    }
+    else if (!isCapped(tile.applied) && isCapped(decision))
+    {
+      tile.cappedSinceMs = nowMs;
+    }
+
+    if (decision.paused != tile.applied.paused)
+    {
+      enables.emplace_back(tile.track, !decision.paused);
+      if (decision.paused)
+      {
+        tile.pausedSinceMs = nowMs;
+      }
+      else
+      {
+        pausedMs_ += nowMs - tile.pausedSinceMs;
+      }
+    }
+
+    json change = { { "consumerId", consumerId }, { "paused", decision.paused } };
+    if (!decision.paused)
+    {
+      change["spatialLayer"] = decision.spatialLayer;
+    }
+    changes.push_back(std::move(change));
+    tile.applied = decision;
+  }
+
+  if (!changes.empty())
+  {
+    ++batches_;
+    changes_ += changes.size();
+  }
+  return changes;
+}
+
+void VisibilityScheduler::notify(const json& changes)
+{
+  MSC_TRACE();
+
+  JNIEnv* env = AttachCurrentThreadIfNeeded();
+  env->CallVoidMethod(j_listener_.obj(), visibilitySchedulerListenerOnScheduleMethod, NativeToJavaJson(env, changes).obj());
+  // Runs on the scheduler thread, where nothing else would clear an exception thrown by the listener.
+  if (env->ExceptionCheck())
+  {
+    MSC_WARN("visibility scheduler listener threw an exception");
+    env->ExceptionDescribe();
+    env->ExceptionClear();
+  }
+}
+
+} // namespace mediasoupclient
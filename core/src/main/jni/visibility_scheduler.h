@@ -0,0 +1,102 @@
+#ifndef VISIBILITY_SCHEDULER_H_
+#define VISIBILITY_SCHEDULER_H_
+
+#include <jni.h>
+#include <sdk/android/native_api/jni/scoped_java_ref.h>
+
+#include <api/media_stream_interface.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "jni_common.h"
+#include "jni_util.h"
+
+namespace mediasoupclient
+{
+
+extern "C"
+{
+
+  JNI_DEFINE_METHOD(void, VisibilityScheduler, nativeSetVisibility, jlong j_scheduler, jlong j_consumer, jboolean j_visible, jint j_width, jint j_height);
+
+  JNI_DEFINE_METHOD(void, VisibilityScheduler, nativeRemove, jlong j_scheduler, jlong j_consumer);
+
+  JNI_DEFINE_METHOD(jstring, VisibilityScheduler, nativeGetMetrics, jlong j_scheduler);
+
+  JNI_DEFINE_METHOD(void, VisibilityScheduler, nativeDispose, jlong j_scheduler);
+}
+
+// Pauses offscreen video consumers and caps the spatial layer of small ones.
+// Visibility reports are debounced and applied in batches: tracks are disabled locally, and the
+// listener is asked to pause, resume or change layers on the server, which is what stops the decoding.
+class VisibilityScheduler final
+{
+public:
+  VisibilityScheduler(JNIEnv* env, const JavaRef<jobject>& j_listener, int debounceMs, std::vector<int> layerHeights);
+  ~VisibilityScheduler();
+
+  VisibilityScheduler(const VisibilityScheduler&) = delete;
+  VisibilityScheduler& operator=(const VisibilityScheduler&) = delete;
+
+  void setVisibility(const std::string& consumerId, webrtc::scoped_refptr<webrtc::MediaStreamTrackInterface> track, int spatialLayers, bool visible, int height);
+  void remove(const std::string& consumerId);
+
+  json metrics();
+
+private:
+  struct Decision
+  {
+    bool paused{ false };
+    int spatialLayer{ -1 };
+
+    bool operator==(const Decision& other) const { return paused == other.paused && spatialLayer == other.spatialLayer; }
+    bool operator!=(const Decision& other) const { return !(*this == other); }
+  };
+
+  struct Tile
+  {
+    webrtc::scoped_refptr<webrtc::MediaStreamTrackInterface> track;
+    int spatialLayers{ 1 };
+    bool visible{ true };
+    int height{ 0 };
+    Decision applied;
+    int64_t pausedSinceMs{ 0 };
+    int64_t cappedSinceMs{ 0 };
+  };
+
+  void run();
+  Decision decide(const Tile& tile) const;
+  // Called with |mutex_| held. Returns the changes to report, and fills the tracks to enable or disable.
+  json apply(int64_t nowMs, std::vector<std::pair<webrtc::scoped_refptr<webrtc::MediaStreamTrackInterface>, bool>>& enables);
+  void notify(const json& changes);
+
+  const ScopedJavaGlobalRef<jobject> j_listener_;
+  const int debounceMs_;
+  const std::vector<int> layerHeights_;
+
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  bool stop_{ false };
+  // Reports not applied yet, and the time of the first and the last of them.
+  bool pending_{ false };
+  int64_t firstPendingMs_{ 0 };
+  int64_t lastPendingMs_{ 0 };
+  std::map<std::string, Tile> tiles_;
+
+  uint64_t batches_{ 0 };
+  uint64_t changes_{ 0 };
+  int64_t pausedMs_{ 0 };
+  int64_t cappedMs_{ 0 };
+
+  std::thread thread_;
+};
+
+} // namespace mediasoupclient
+
+#endif // VISIBILITY_SCHEDULER_H_
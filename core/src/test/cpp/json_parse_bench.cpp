@@ -0,0 +1,74 @@
+// Parse times of the signaling JSON with nlohmann::json and with parseJson() built with MSC_USE_SIMDJSON.
+// The documents are the androidTest SDPs and generated sessions, converted to JSON by sdptransform.
+//
+//   $ json_parse_bench [iterations]
+
+#include <sdptransform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "json_parse.h"
+#include "sdp_corpus.h"
+
+namespace
+{
+
+// Keeps the parsed documents alive as far as the optimizer can tell.
+size_t sink = 0;
+
+double microsPerRun(int iterations, const std::function<void()>& run)
+{
+  run();
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+  {
+    run();
+  }
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+void bench(const std::string& name, const std::string& text, int iterations)
+{
+  // Both must produce the same document before their times mean anything.
+  if (mediasoupclient::parseJson(text) != json::parse(text))
+  {
+    std::fprintf(stderr, "%s: parseJson differs from nlohmann::json\n", name.c_str());
+    std::exit(1);
+  }
+
+  auto nlohmann = microsPerRun(iterations, [&]() { sink += json::parse(text).size(); });
+  auto simdjson = microsPerRun(iterations, [&]() { sink += mediasoupclient::parseJson(text).size(); });
+  // Only a couple of small members materialized, as Device.load does with the router capabilities.
+  auto fields = microsPerRun(iterations, [&]() { sink += mediasoupclient::parseJson(text, { "origin", "timing" }).size(); });
+
+  std::printf("%-32s %8zu %10.1f %10.1f %6.1fx %10.1f %6.1fx\n", name.c_str(), text.size(), nlohmann, simdjson, nlohmann / simdjson, fields, nlohmann / fields);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  const int iterations = argc > 1 ? std::atoi(argv[1]) : 500;
+
+  std::vector<std::pair<std::string, std::string>> documents;
+  for (const auto& name : sdp_corpus::kAssetNames)
+  {
+    documents.emplace_back(name, sdptransform::parse(sdp_corpus::loadAsset(name)).dump());
+  }
+  documents.emplace_back("generated 16m 4c simulcast", sdptransform::parse(sdp_corpus::generateSdp(16, 4, true)).dump());
+  documents.emplace_back("generated 64m 6c simulcast", sdptransform::parse(sdp_corpus::generateSdp(64, 6, true)).dump());
+
+  std::printf("%-32s %8s %10s %10s %7s %10s %7s\n", "json (us per run)", "bytes", "nlohmann", "parseJson", "", "2 fields", "");
+  for (const auto& [name, text] : documents)
+  {
+    bench(name, text, std::max(1, iterations * 4096 / static_cast<int>(text.size() + 4096)));
+  }
+  return sink == 0 ? 1 : 0;
+}
@@ -0,0 +1,88 @@
+// Checks that parseJson() built with MEDIASOUPCLIENT_USE_SIMDJSON, and without the verification of debug builds,
+// gives the nlohmann::json result for documents simdjson rejects but nlohmann accepts, and still fails on invalid ones.
+
+#include <iostream>
+#include <string>
+
+#include "json_parse.h"
+
+using json = nlohmann::json;
+
+namespace
+{
+
+int failures = 0;
+
+void expectParsed(const std::string& what, const std::string& text, std::initializer_list<const char*> fields = {})
+{
+  json expected = json::parse(text);
+  if (fields.size() != 0)
+  {
+    auto selected = json::object();
+    for (auto field : fields)
+    {
+      if (expected.contains(field))
+      {
+        selected[field] = expected[field];
+      }
+    }
+    expected = selected;
+  }
+
+  try
+  {
+    auto actual = mediasoupclient::parseJson(text, fields);
+    if (actual != expected)
+    {
+      ++failures;
+      std::cerr << "FAIL " << what << "\n  diff: " << json::diff(expected, actual).dump() << "\n";
+    }
+  }
+  catch (const std::exception& error)
+  {
+    ++failures;
+    std::cerr << "FAIL " << what << "\n  threw: " << error.what() << "\n";
+  }
+}
+
+void expectRejected(const std::string& what, const std::string& text)
+{
+  try
+  {
+    mediasoupclient::parseJson(text);
+    ++failures;
+    std::cerr << "FAIL " << what << "\n  accepted\n";
+  }
+  catch (const json::parse_error&)
+  {
+  }
+  catch (const std::exception& error)
+  {
+    ++failures;
+    std::cerr << "FAIL " << what << "\n  threw other than nlohmann::json::parse_error: " << error.what() << "\n";
+  }
+}
+
+} // namespace
+
+int main()
+{
+  expectParsed("plain object", R"({"id":"a","kind":"audio","ssrc":1234,"rtx":null})");
+  expectParsed("selected fields", R"({"id":"a","kind":"audio","ssrc":1234})", { "id", "ssrc" });
+
+  // simdjson rejects both, nlohmann takes the first as a double and has no depth limit.
+  expectParsed("integer beyond 64 bits", R"({"bitrate":18446744073709551616})");
+  expectParsed("integer beyond 64 bits in a selected field", R"({"bitrate":18446744073709551616,"id":"a"})", { "bitrate" });
+  expectParsed("deep nesting", std::string(2000, '[') + std::string(2000, ']'));
+
+  expectRejected("truncated object", R"({"id":"a",)");
+  expectRejected("trailing garbage", R"({"id":"a"} x)");
+
+  if (failures != 0)
+  {
+    std::cerr << failures << " failures\n";
+    return 1;
+  }
+  std::cout << "OK\n";
+  return 0;
+}
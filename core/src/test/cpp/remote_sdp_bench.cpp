@@ -0,0 +1,95 @@
+// Time spent by RemoteSdp in Receive() and GetSdp() while a receive transport consumes one track after the other,
+// that is the whole remote side of RecvTransport.consume but the ortc checks and the PeerConnection.
+// Built once with libsdptransform and once, as remote_sdp_bench_fast, with the fast writer and a transport's cache.
+//
+//   $ remote_sdp_bench [consumes]
+//   $ remote_sdp_bench_fast [consumes]
+
+#include <sdp/RemoteSdp.hpp>
+#include <sdptransform.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#ifdef REMOTE_SDP_BENCH_FAST
+#include "sdp_transform.h"
+#endif
+
+namespace
+{
+
+const json iceParameters = { { "iceLite", true }, { "password", "yku5ej8nvfaor28lvtrabcx0wkrpkztz" }, { "usernameFragment", "h3hk1iz6qqlnqlne" } };
+
+const json iceCandidates = json::array({
+  { { "foundation", "udpcandidate" }, { "ip", "192.0.2.1" }, { "port", 40533 }, { "priority", 1078862079 }, { "protocol", "udp" }, { "type", "host" } },
+});
+
+const json dtlsParameters = {
+  { "fingerprints", json::array({ { { "algorithm", "sha-256" }, { "value", "A9:F4:E0:D2:74:D3:0F:D9:2E:69:5E:E7:EA:F1:48:5E:B2:E7:08:24:0D:B3:19:30:4D:F8:2A:0A:83:F2:E2:1B" } } }) },
+  { "role", "auto" },
+};
+
+const json sctpParameters = { { "port", 5000 }, { "OS", 1024 }, { "MIS", 1024 }, { "maxMessageSize", 262144 } };
+
+// RTP parameters of a VP8 Consumer with RTX, as the router sends them.
+json videoRtpParameters(int index)
+{
+  auto ssrc = 10000000 + index * 2;
+  return {
+    { "codecs",
+      json::array({
+        { { "mimeType", "video/VP8" }, { "payloadType", 101 }, { "clockRate", 90000 }, { "parameters", json::object() },
+          { "rtcpFeedback", json::array({ { { "type", "nack" } }, { { "type", "nack" }, { "parameter", "pli" } }, { { "type", "ccm" }, { "parameter", "fir" } },
+                                          { { "type", "goog-remb" } }, { { "type", "transport-cc" } } }) } },
+        { { "mimeType", "video/rtx" }, { "payloadType", 102 }, { "clockRate", 90000 }, { "parameters", { { "apt", 101 } } }, { "rtcpFeedback", json::array() } },
+      }) },
+    { "encodings", json::array({ { { "ssrc", ssrc }, { "rtx", { { "ssrc", ssrc + 1 } } } } }) },
+    { "headerExtensions",
+      json::array({
+        { { "uri", "urn:ietf:params:rtp-hdrext:sdes:mid" }, { "id", 1 } },
+        { { "uri", "http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01" }, { "id", 5 } },
+      }) },
+    { "rtcp", { { "cname", "consumer" + std::to_string(index) }, { "reducedSize", true }, { "mux", true } } },
+  };
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  const int consumes = argc > 1 ? std::atoi(argv[1]) : 200;
+
+  mediasoupclient::Sdp::RemoteSdp remoteSdp(iceParameters, iceCandidates, dtlsParameters, sctpParameters);
+#ifdef REMOTE_SDP_BENCH_FAST
+  sdptransform::WriteCache cache;
+#endif
+
+  std::chrono::steady_clock::duration receive{};
+  std::chrono::steady_clock::duration write{};
+  for (int i = 0; i < consumes; ++i)
+  {
+    auto rtpParameters = videoRtpParameters(i);
+    auto mid = std::to_string(i);
+#ifdef REMOTE_SDP_BENCH_FAST
+    sdptransform::WriteCacheScope scope(cache);
+#endif
+
+    auto start = std::chrono::steady_clock::now();
+    remoteSdp.Receive(mid, "video", rtpParameters, "stream" + mid, "track" + mid);
+    auto received = std::chrono::steady_clock::now();
+    auto sdp = remoteSdp.GetSdp();
+    auto written = std::chrono::steady_clock::now();
+    if (sdp.empty())
+    {
+      std::abort();
+    }
+    receive += received - start;
+    write += written - received;
+  }
+
+  std::cout << consumes << " consumes: Receive " << std::chrono::duration<double, std::milli>(receive).count() << " ms, GetSdp "
+            << std::chrono::duration<double, std::milli>(write).count() << " ms\n";
+  return 0;
+}
@@ -0,0 +1,72 @@
+// Parse and write times of libsdptransform and of the fast sdptransform, on the androidTest SDPs
+// and on generated sessions with many m-sections, codecs and simulcast.
+//
+//   $ sdp_bench [iterations]
+
+#include <sdptransform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "sdp_corpus.h"
+#include "sdptransform_fast.hpp"
+
+namespace
+{
+
+double microsPerRun(int iterations, const std::function<void()>& run)
+{
+  // Warm up, so the first run does not pay for the regex compilation and the caches.
+  run();
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+  {
+    run();
+  }
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+void bench(const std::string& name, const std::string& sdp, int iterations)
+{
+  auto session = sdptransform::parse(sdp);
+
+  auto referenceParse = microsPerRun(iterations, [&]() { sdptransform::parse(sdp); });
+  auto fastParse = microsPerRun(iterations, [&]() { sdptransform_fast::parse(sdp); });
+  auto referenceWrite = microsPerRun(iterations, [&]() { sdptransform::write(session); });
+  // Without a media section cache, to time the writer itself.
+  auto fastWrite = microsPerRun(iterations, [&]() { sdptransform_fast::write(session); });
+
+  std::printf("%-32s %8zu %10.1f %10.1f %6.1fx %10.1f %10.1f %6.1fx\n", name.c_str(), sdp.size(), referenceParse, fastParse, referenceParse / fastParse, referenceWrite, fastWrite,
+              referenceWrite / fastWrite);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  const int iterations = argc > 1 ? std::atoi(argv[1]) : 200;
+
+  std::printf("%-32s %8s %10s %10s %7s %10s %10s %7s\n", "sdp (us per run)", "bytes", "parse", "fast", "", "write", "fast", "");
+  for (const auto& name : sdp_corpus::kAssetNames)
+  {
+    bench(name, sdp_corpus::loadAsset(name), iterations);
+  }
+
+  struct Generated
+  {
+    int mSections;
+    int codecs;
+    bool simulcast;
+  };
+  for (const auto& [mSections, codecs, simulcast] : std::vector<Generated>{ { 2, 1, false }, { 2, 6, true }, { 16, 4, true }, { 64, 6, true }, { 200, 2, false } })
+  {
+    auto name = "generated " + std::to_string(mSections) + "m " + std::to_string(codecs) + "c" + (simulcast ? " simulcast" : "");
+    bench(name, sdp_corpus::generateSdp(mSections, codecs, simulcast), std::max(1, iterations * 4 / (mSections + 4)));
+  }
+  return 0;
+}
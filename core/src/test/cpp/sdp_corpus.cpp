@@ -0,0 +1,191 @@
+#include "sdp_corpus.h"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace sdp_corpus
+{
+
+const std::vector<std::string> kAssetNames = { "audio_video.sdp", "jssip.sdp", "webrtc.sdp" };
+
+std::string loadAsset(const std::string& name)
+{
+  std::ifstream file(std::string(SDP_ASSETS_DIR) + "/" + name, std::ios::binary);
+  if (!file)
+  {
+    throw std::runtime_error("cannot open " + name);
+  }
+  std::ostringstream text;
+  text << file.rdbuf();
+  return text.str();
+}
+
+namespace
+{
+
+struct Codec
+{
+  const char* name;
+  int rate;
+  int channels;
+  const char* fmtp;
+};
+
+constexpr Codec kAudioCodecs[] = {
+  { "opus", 48000, 2, "minptime=10;useinbandfec=1;usedtx=1" },
+  { "multiopus", 48000, 6, "channel_mapping=0,4,1,2,3,5;num_streams=4;coupled_streams=2" },
+  { "G722", 8000, 1, nullptr },
+  { "PCMU", 8000, 1, nullptr },
+  { "PCMA", 8000, 1, nullptr },
+  { "telephone-event", 48000, 1, "0-15" },
+};
+
+constexpr Codec kVideoCodecs[] = {
+  { "VP8", 90000, 0, "x-google-start-bitrate=1000" },
+  { "VP9", 90000, 0, "profile-id=2" },
+  { "H264", 90000, 0, "level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=42e01f" },
+  { "H264", 90000, 0, "level-asymmetry-allowed=1;packetization-mode=0;profile-level-id=4d001f" },
+  { "AV1", 90000, 0, nullptr },
+  { "H265", 90000, 0, nullptr },
+};
+
+template <size_t N>
+const Codec& codecAt(const Codec (&codecs)[N], int index)
+{
+  return codecs[static_cast<size_t>(index) % N];
+}
+
+void appendMediaSection(std::ostringstream& sdp, int index, int codecs, bool simulcast)
+{
+  const bool video = index % 2 == 1;
+  const int firstPayload = 96;
+  const uint32_t ssrc = 100000000u + static_cast<uint32_t>(index) * 16u;
+
+  // RTX follows each video codec.
+  std::vector<int> payloads;
+  for (int i = 0; i < codecs; ++i)
+  {
+    payloads.push_back(firstPayload + (video ? 2 * i : i));
+    if (video)
+    {
+      payloads.push_back(firstPayload + 2 * i + 1);
+    }
+  }
+
+  sdp << "m=" << (video ? "video" : "audio") << " 7 UDP/TLS/RTP/SAVPF";
+  for (auto payload : payloads)
+  {
+    sdp << " " << payload;
+  }
+  sdp << "\r\n";
+  sdp << "c=IN IP4 127.0.0.1\r\n";
+  sdp << "b=AS:" << (video ? 2500 : 64) << "\r\n";
+
+  for (int i = 0; i < codecs; ++i)
+  {
+    const auto& codec = video ? codecAt(kVideoCodecs, i) : codecAt(kAudioCodecs, i);
+    const int payload = firstPayload + (video ? 2 * i : i);
+    sdp << "a=rtpmap:" << payload << " " << codec.name << "/" << codec.rate;
+    if (codec.channels > 1)
+    {
+      sdp << "/" << codec.channels;
+    }
+    sdp << "\r\n";
+    if (codec.fmtp != nullptr)
+    {
+      sdp << "a=fmtp:" << payload << " " << codec.fmtp << "\r\n";
+    }
+    sdp << "a=rtcp-fb:" << payload << " transport-cc\r\n";
+    if (video)
+    {
+      sdp << "a=rtcp-fb:" << payload << " goog-remb\r\n";
+      sdp << "a=rtcp-fb:" << payload << " ccm fir\r\n";
+      sdp << "a=rtcp-fb:" << payload << " nack\r\n";
+      sdp << "a=rtcp-fb:" << payload << " nack pli\r\n";
+      sdp << "a=rtpmap:" << payload + 1 << " rtx/90000\r\n";
+      sdp << "a=fmtp:" << payload + 1 << " apt=" << payload << "\r\n";
+    }
+    else
+    {
+      sdp << "a=rtcp-fb:" << payload << " nack\r\n";
+    }
+  }
+
+  sdp << "a=extmap:1 urn:ietf:params:rtp-hdrext:sdes:mid\r\n";
+  sdp << "a=extmap:4 http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time\r\n";
+  sdp << "a=extmap:5 http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01\r\n";
+  if (video)
+  {
+    sdp << "a=extmap:11 urn:3gpp:video-orientation\r\n";
+    sdp << "a=extmap:12 urn:ietf:params:rtp-hdrext:toffset\r\n";
+    sdp << "a=extmap:2 urn:ietf:params:rtp-hdrext:sdes:rtp-stream-id\r\n";
+    sdp << "a=extmap:3 urn:ietf:params:rtp-hdrext:sdes:repaired-rtp-stream-id\r\n";
+  }
+  else
+  {
+    sdp << "a=extmap:10 urn:ietf:params:rtp-hdrext:ssrc-audio-level\r\n";
+  }
+
+  sdp << "a=setup:actpass\r\n";
+  sdp << "a=mid:" << index << "\r\n";
+  sdp << "a=msid:stream-" << index << " track-" << index << "\r\n";
+  sdp << "a=sendonly\r\n";
+  sdp << "a=ice-ufrag:ufrag" << index << "\r\n";
+  sdp << "a=ice-pwd:pwdpwdpwdpwdpwdpwdpwd" << index << "\r\n";
+  sdp << "a=candidate:udpcandidate 1 udp 1076302079 192.0.2.1 40000 typ host\r\n";
+  sdp << "a=candidate:tcpcandidate 1 tcp 1076276479 192.0.2.1 40001 typ host tcptype passive\r\n";
+  sdp << "a=end-of-candidates\r\n";
+  sdp << "a=ice-options:renomination\r\n";
+  sdp << "a=rtcp-mux\r\n";
+  sdp << "a=rtcp-rsize\r\n";
+
+  const int streams = video && simulcast ? 3 : 1;
+  if (video && simulcast)
+  {
+    for (int i = 0; i < streams; ++i)
+    {
+      sdp << "a=rid:r" << i << " send\r\n";
+    }
+    sdp << "a=simulcast:send r0;r1;~r2\r\n";
+  }
+  for (int i = 0; i < streams; ++i)
+  {
+    const auto id = ssrc + static_cast<uint32_t>(2 * i);
+    sdp << "a=ssrc:" << id << " cname:cname" << index << "\r\n";
+    sdp << "a=ssrc:" << id << " msid:stream-" << index << " track-" << index << "\r\n";
+    if (video)
+    {
+      sdp << "a=ssrc:" << id + 1 << " cname:cname" << index << "\r\n";
+      sdp << "a=ssrc-group:FID " << id << " " << id + 1 << "\r\n";
+    }
+  }
+}
+
+} // namespace
+
+std::string generateSdp(int mSections, int codecs, bool simulcast)
+{
+  std::ostringstream sdp;
+  sdp << "v=0\r\n";
+  sdp << "o=mediasoup-client 1000000 " << mSections << " IN IP4 0.0.0.0\r\n";
+  sdp << "s=-\r\n";
+  sdp << "t=0 0\r\n";
+  sdp << "a=ice-lite\r\n";
+  sdp << "a=group:BUNDLE";
+  for (int i = 0; i < mSections; ++i)
+  {
+    sdp << " " << i;
+  }
+  sdp << "\r\n";
+  sdp << "a=msid-semantic: WMS *\r\n";
+  sdp << "a=fingerprint:sha-256 79:14:AB:AB:93:7F:07:E8:91:1A:11:16:36:D0:11:66:C4:4F:31:A0:74:46:65:58:70:E5:09:95:48:F4:4B:D9\r\n";
+  sdp << "a=extmap-allow-mixed\r\n";
+  for (int i = 0; i < mSections; ++i)
+  {
+    appendMediaSection(sdp, i, codecs, simulcast);
+  }
+  return sdp.str();
+}
+
+} // namespace sdp_corpus
@@ -0,0 +1,21 @@
+#ifndef SDP_CORPUS_H_
+#define SDP_CORPUS_H_
+
+#include <string>
+#include <vector>
+
+namespace sdp_corpus
+{
+
+// SDPs of src/androidTest/assets.
+extern const std::vector<std::string> kAssetNames;
+
+std::string loadAsset(const std::string& name);
+
+// A session as RemoteSdp builds it for a receive transport: alternating audio and video m-sections,
+// each with the given number of codecs (and their RTX), and three simulcast layers on video when asked.
+std::string generateSdp(int mSections, int codecs, bool simulcast);
+
+} // namespace sdp_corpus
+
+#endif // SDP_CORPUS_H_
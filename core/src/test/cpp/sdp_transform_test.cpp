@@ -0,0 +1,167 @@
+// Compares the handwritten sdptransform of MEDIASOUPCLIENT_FAST_SDP with the reference one field for field,
+// on the androidTest SDPs and on generated sessions with many m-sections, codecs and simulcast.
+
+#include <sdptransform.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+#include "sdp_corpus.h"
+#include "sdptransform_fast.hpp"
+
+namespace
+{
+
+int failures = 0;
+
+void expectEqual(const std::string& what, const json& expected, const json& actual)
+{
+  if (expected == actual)
+  {
+    return;
+  }
+  ++failures;
+  std::cerr << "FAIL " << what << "\n  diff: " << json::diff(expected, actual).dump() << "\n";
+}
+
+void expectEqual(const std::string& what, const std::string& expected, const std::string& actual)
+{
+  if (expected == actual)
+  {
+    return;
+  }
+  ++failures;
+  auto at = std::mismatch(expected.begin(), expected.end(), actual.begin(), actual.end()).first - expected.begin();
+  auto lineStart = expected.rfind('\n', static_cast<size_t>(at));
+  lineStart = lineStart == std::string::npos ? 0 : lineStart + 1;
+  std::cerr << "FAIL " << what << "\n  first difference at offset " << at << ", in line: " << expected.substr(lineStart, expected.find('\n', lineStart) - lineStart) << "\n";
+}
+
+void compareHelpers(const std::string& name, const json& session)
+{
+  for (const auto& mLine : session["media"])
+  {
+    if (mLine.contains("payloads") && mLine["payloads"].is_string())
+    {
+      const auto& payloads = mLine["payloads"].get_ref<const std::string&>();
+      if (mLine.value("protocol", "").find("RTP") != std::string::npos)
+      {
+        expectEqual(name + " parsePayloads(" + payloads + ")", json(sdptransform::parsePayloads(payloads)), json(sdptransform_fast::parsePayloads(payloads)));
+      }
+    }
+    for (const auto& fmtp : mLine.value("fmtp", json::array()))
+    {
+      const auto& config = fmtp["config"].get_ref<const std::string&>();
+      expectEqual(name + " parseParams(" + config + ")", sdptransform::parseParams(config), sdptransform_fast::parseParams(config));
+    }
+    if (mLine.contains("simulcast"))
+    {
+      for (const auto* key : { "list1", "list2" })
+      {
+        if (mLine["simulcast"].contains(key))
+        {
+          const auto& list = mLine["simulcast"][key].get_ref<const std::string&>();
+          expectEqual(name + " parseSimulcastStreamList(" + list + ")", sdptransform::parseSimulcastStreamList(list), sdptransform_fast::parseSimulcastStreamList(list));
+        }
+      }
+    }
+  }
+}
+
+void compare(const std::string& name, const std::string& sdp)
+{
+  auto expected = sdptransform::parse(sdp);
+  auto actual = sdptransform_fast::parse(sdp);
+  expectEqual(name + " parse", expected, actual);
+
+  compareHelpers(name, expected);
+
+  // write() fills in missing properties, so each implementation gets its own copy.
+  auto referenceSession = expected;
+  auto fastSession = expected;
+  auto text = sdptransform::write(referenceSession);
+  expectEqual(name + " write", text, sdptransform_fast::write(fastSession));
+  expectEqual(name + " write session", referenceSession, fastSession);
+
+  {
+    // The first write stamps the sections, the second keeps their text and the next ones reuse it.
+    sdptransform_fast::WriteCache cache;
+    sdptransform_fast::WriteCacheScope scope(cache);
+    auto cachedSession = fastSession;
+    for (const auto* run : { " write stamped", " write kept", " write cached" })
+    {
+      expectEqual(name + run, text, sdptransform_fast::write(cachedSession));
+    }
+
+    // Another transport shares nothing, even for a copy of the session.
+    sdptransform_fast::WriteCache otherCache;
+    sdptransform_fast::WriteCacheScope otherScope(otherCache);
+    auto copiedSession = cachedSession;
+    expectEqual(name + " write copied", text, sdptransform_fast::write(copiedSession));
+  }
+
+  {
+    sdptransform_fast::WriteCache cache;
+    sdptransform_fast::WriteCacheScope scope(cache);
+    auto cachedSession = fastSession;
+    sdptransform_fast::write(cachedSession);
+    sdptransform_fast::write(cachedSession);
+
+    // An m-section replaced the way RemoteSdp does, while the others are served from the cache.
+    if (!expected["media"].empty())
+    {
+      referenceSession["media"][0]["direction"] = "inactive";
+      auto mLine = cachedSession["media"][0];
+      mLine["direction"] = "inactive";
+      cachedSession["media"][0] = std::move(mLine);
+      auto changed = sdptransform::write(referenceSession);
+      expectEqual(name + " write changed", changed, sdptransform_fast::write(cachedSession));
+
+      // And one appended, as on each consume.
+      referenceSession["media"].push_back(expected["media"][0]);
+      cachedSession["media"].push_back(expected["media"][0]);
+      expectEqual(name + " write appended", sdptransform::write(referenceSession), sdptransform_fast::write(cachedSession));
+    }
+
+    cache.clear();
+    expectEqual(name + " write cleared", sdptransform::write(referenceSession), sdptransform_fast::write(cachedSession));
+  }
+
+  expectEqual(name + " parse written", sdptransform::parse(text), sdptransform_fast::parse(text));
+}
+
+} // namespace
+
+int main()
+{
+  for (const auto& name : sdp_corpus::kAssetNames)
+  {
+    compare(name, sdp_corpus::loadAsset(name));
+  }
+
+  for (int mSections : { 1, 2, 16, 64 })
+  {
+    for (int codecs : { 1, 4, 6 })
+    {
+      for (bool simulcast : { false, true })
+      {
+        auto name = "generated(" + std::to_string(mSections) + ", " + std::to_string(codecs) + ", " + (simulcast ? "simulcast" : "single") + ")";
+        compare(name, sdp_corpus::generateSdp(mSections, codecs, simulcast));
+      }
+    }
+  }
+
+  for (const auto* str : { "[x=800,y=640]", "[x=[400:16:800],y=[320:16:640],sar=[0.9-1.1],par=1.3333,q=0.6] [x=480,y=320]" })
+  {
+    expectEqual(std::string("parseImageAttributes(") + str + ")", sdptransform::parseImageAttributes(str), sdptransform_fast::parseImageAttributes(str));
+  }
+
+  if (failures != 0)
+  {
+    std::cerr << failures << " differences\n";
+    return 1;
+  }
+  std::cout << "fast sdptransform matches the reference\n";
+  return 0;
+}
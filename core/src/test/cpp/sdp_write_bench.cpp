@@ -0,0 +1,66 @@
+// Time spent in write() while a receive transport consumes one m-section after the other,
+// the way RemoteSdp serializes the whole session again on each consume.
+//
+//   $ sdp_write_bench [m-sections]
+
+#include <sdptransform.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#include "sdp_corpus.h"
+#include "sdptransform_fast.hpp"
+
+namespace
+{
+
+double cumulativeMillis(const json& base, int mSections, const std::function<std::string(json&)>& write)
+{
+  const auto& templates = base["media"];
+  auto session = base;
+  session["media"] = json::array();
+
+  std::chrono::steady_clock::duration total{};
+  for (int i = 0; i < mSections; ++i)
+  {
+    auto mLine = templates[static_cast<size_t>(i) % templates.size()];
+    mLine["mid"] = std::to_string(i);
+    session["media"].push_back(std::move(mLine));
+
+    auto start = std::chrono::steady_clock::now();
+    auto sdp = write(session);
+    total += std::chrono::steady_clock::now() - start;
+    if (sdp.empty())
+    {
+      std::abort();
+    }
+  }
+  return std::chrono::duration<double, std::milli>(total).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  const int mSections = argc > 1 ? std::atoi(argv[1]) : 200;
+
+  for (const auto& [name, sdp] : { std::make_pair(std::string("webrtc.sdp"), sdp_corpus::loadAsset("webrtc.sdp")),
+                                   std::make_pair(std::string("generated"), sdp_corpus::generateSdp(2, 4, true)) })
+  {
+    auto base = sdptransform::parse(sdp);
+
+    auto reference = cumulativeMillis(base, mSections, [](json& session) { return sdptransform::write(session); });
+    auto uncached = cumulativeMillis(base, mSections, [](json& session) { return sdptransform_fast::write(session); });
+    sdptransform_fast::WriteCache cache;
+    auto cached = cumulativeMillis(base, mSections, [&cache](json& session) {
+      sdptransform_fast::WriteCacheScope scope(cache);
+      return sdptransform_fast::write(session);
+    });
+
+    std::cout << name << ", " << mSections << " consumes: reference " << reference << " ms, fast " << uncached << " ms, fast with cache " << cached << " ms\n";
+  }
+  return 0;
+}
@@ -0,0 +1,31 @@
+#ifndef SDPTRANSFORM_FAST_HPP_
+#define SDPTRANSFORM_FAST_HPP_
+
+#include <sdptransform.hpp>
+
+#include <string>
+#include <vector>
+
+// src/main/jni/sdp_transform.cpp compiled with sdptransform=sdptransform_fast, next to the reference sdptransform.
+namespace sdptransform_fast
+{
+
+json parse(const std::string& sdp);
+
+json parseParams(const std::string& str);
+
+std::vector<int> parsePayloads(const std::string& str);
+
+json parseImageAttributes(const std::string& str);
+
+json parseSimulcastStreamList(const std::string& str);
+
+std::string write(json& session);
+
+} // namespace sdptransform_fast
+
+#define sdptransform sdptransform_fast
+#include "sdp_transform.h"
+#undef sdptransform
+
+#endif // SDPTRANSFORM_FAST_HPP_